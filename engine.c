@@ -0,0 +1,1899 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "engine.h"
+
+typedef struct TripReader
+{
+	FILE *srcPtr;					// Trip file being read
+	char buffer[READ_BUFFER_SIZE];	// Block of bytes read from the file
+	int ctrPos;						// Index of the next unread byte in the buffer
+	int ctrLen;						// Number of bytes currently in the buffer
+	int lineNum;					// Line number of the next unread byte.	Example: 12
+} TripReader;
+
+typedef struct SnapshotHeader
+{
+	char magic[8];					// Identifies a snapshot file.	Example: "AESNAP1"
+	int currentDate;				// Date of the trip file.		Example: 03212020
+	int busSize;					// Size of each bus record, which changes when the Bus structure does
+	long tripSize;					// Size of the trip file when the snapshot was taken
+} SnapshotHeader;
+
+typedef struct TraceSpan
+{
+	const char *spanName;			// Step being timed.				Example: "saveToTripFile"
+	int ticketNum;					// Ticket being handled, or -1 if none
+	int busNum;						// Bus being handled, or 0 if none
+	long long startTime;			// Start of the step in microseconds
+	long long duration;				// Length of the step in microseconds
+} TraceSpan;
+
+static struct TraceSpan traceRing[TRACE_LIMIT];	// Most recent spans, overwritten oldest first once full
+static long ctrTraced = 0;							// Number of spans recorded since tracing was enabled
+static int isTraceEnabled = 0;						// Set by enableTrace
+
+static const struct Layout layoutTable[LAYOUT_LIMIT] = {		// List of vehicle layouts, seats are numbered from the back row and left to right
+	{13, 3, 5, {"SSS", "SSS", "SSS", "SSS", "SD"}, LAYOUT16},
+	{16, 4, 5, {"SSSS", "SSSS", "SSSS", "ASSS", "SD"}, -1},
+	{22, 4, 8, {"SSSS", "SSAS", "SSAS", "SSAS", "SSAS", "SSAS", "SSAS", "AD"}, -1},
+	{29, 5, 8, {"SSSSS", "SSASS", "SSASS", "SSASS", "SSASS", "SSASS", "SSASS", "AD"}, -1}
+};
+
+static int busSchedule[FLEET_LIMIT][3] = {		// Active list of bus schedules, corresponding departure time and vehicle layout, replaced by the schedule file
+	// Manila to Laguna (101-109)
+	{101, 600, LAYOUT13}, {102, 730, LAYOUT13}, {103, 930, LAYOUT13}, {104, 1100, LAYOUT13}, {105, 1300, LAYOUT13}, {106, 1430, LAYOUT13}, {107, 1530, LAYOUT13}, {108, 1700, LAYOUT13}, {109, 1815, LAYOUT13},
+	// Laguna to Manila (150-160)
+	{150, 530, LAYOUT13}, {151, 545, LAYOUT13}, {152, 700, LAYOUT13}, {153, 730, LAYOUT13}, {154, 900, LAYOUT13}, {155, 1100, LAYOUT13}, {156, 1300, LAYOUT13}, {157, 1430, LAYOUT13}, {158, 1530, LAYOUT13}, {159, 1700, LAYOUT13}, {160, 1815, LAYOUT13}
+};
+
+/* SPECIFIC INPUT VERIFICATION FUNCTIONS */
+/* Determines if the year is a leap year */
+int checkIfLeap(int inputYear)
+{
+	if ((inputYear % 4 == 0 && inputYear % 100 != 0) || inputYear % 400 == 0)
+		return 1;
+	else
+		return 0;
+}
+/* Determines number of days in a month */
+int getDaysInMonth(int inputDate)
+{
+	int inputMonth = inputDate / 1000000;
+	int inputYear = inputDate % 10000;
+	switch (inputMonth)
+	{
+		case 1:
+		case 3:
+		case 5:
+		case 7:
+		case 8:
+		case 10:
+		case 12:
+			return 31;
+			break;
+		case 4:
+		case 6:
+		case 9:
+		case 11:
+			return 30;
+			break;
+		case 2:
+			if (checkIfLeap(inputYear))
+				return 29;
+			else
+				return 28;
+		default:
+			return 0;
+			break;
+	}
+}
+/* Returns the day after the given date, both in MMDDYYYY format */
+int getNextDate(int inputDate)
+{
+	int month = inputDate / 1000000;
+	int day = (inputDate / 10000) % 100;
+	int year = inputDate % 10000;
+
+	if (day < getDaysInMonth(inputDate))
+		day++;
+	else
+	{
+		day = 1;
+		if (month < 12)
+			month++;
+		else
+		{
+			month = 1;
+			year++;
+		}
+	}
+
+	return month * 1000000 + day * 10000 + year;
+}
+/* Converts a date in MMDDYYYY format into YYYYMMDD format so that dates can be compared */
+int getSortableDate(int inputDate)
+{
+	return (inputDate % 10000) * 10000 + (inputDate / 1000000) * 100 + (inputDate / 10000) % 100;
+}
+/* Validate if the given inputDate has a valid day of a month */
+int checkIfDay(int inputDate, int numDaysInMonth)
+{
+	if (inputDate > 0)
+	{
+		inputDate /= 10000;
+		inputDate %= 100;
+		if (inputDate <= numDaysInMonth)
+			return 1;
+	}
+
+	return 0;
+}
+/* Validate if the given inputDate has a valid month of a year */
+int checkIfMonth(int inputDate)
+{
+	inputDate /= 1000000;
+	if (inputDate >= 1 && inputDate <= 12)
+		return 1;
+	else
+		return 0;
+}
+/* Validate if the given inputTime is in 24H time format */
+int checkIf24H(int inputTime)
+{
+	if (!(inputTime / 100 < 24 && inputTime % 100 < 60) || inputTime < 0)
+		return 0;
+	else
+		return 1;
+}
+/* Verifies if the given ID number is at least 7 to 8 digits long */
+int verifyIDNumber(int inputNum)
+{
+	int ctrID = 0;
+	while (inputNum > 0)
+	{
+		inputNum /= 10;
+		ctrID++;
+	}
+
+	if (ctrID >= 7 && ctrID <= 8) // checks that ID numbers are 7-8 digits only
+		return 1;
+	else
+		return 0;
+}
+/* Verifies if the given drop-off code is valid. If valid, it returns the index + 1 of the drop-off code. */
+int verifyDropOff(int inputKey, int inputTime, int entryPoint)
+{
+	int specialCase;
+	if (inputTime > 1529 && inputTime < 1815)	// only allows drop-off code 104 for AE108 and AE109
+		specialCase = 1;
+	else
+		specialCase = 0;
+
+	switch (entryPoint)
+	{
+		case 1:						// Manila -> Laguna routes only
+			switch (inputKey)
+			{
+				case 101:
+					return 1;
+					break;
+				case 102:
+					return 2;
+					break;
+				case 103:
+				case 112:
+					return 3;
+					break;
+				case 111:
+					return 5;
+					break;
+				case 104:
+					if (specialCase)
+						return 4;
+					else
+						return 0;
+					break;
+				default:
+					return 0; // returns only if invalid
+					break;
+			}
+		case 2:					// Laguna -> Manila routes only
+			switch (inputKey)
+			{
+				case 201:
+					return 6;
+					break;
+				case 221:
+					return 7;
+					break;
+				case 211:
+				case 222:
+					return 8;
+					break;
+				case 212:
+				case 223:
+					return 9;
+					break;
+				case 213:
+				case 224:
+					return 10;
+					break;
+
+				default:
+					return 0; // returns only if invalid
+					break;
+			}
+		default:
+			return 0;
+			break;
+	}
+}
+
+/* Returns 1 if the given bus number belongs to the route of the given point of entry, otherwise 0 */
+int checkRoute(int busNum, int entryPoint)
+{
+	switch (entryPoint)
+	{
+		case 1:						// Manila -> Laguna (101-109)
+			return busNum > 100 && busNum < 110;
+			break;
+		case 2:						// Laguna -> Manila (150-160)
+			return busNum > 149 && busNum < 161;
+			break;
+		default:
+			return 0;
+			break;
+	}
+}
+/* Verifies every passenger detail of a ticket. Returns RESERVE_OK if valid, otherwise RESERVE_INVALID. */
+int validateTicket(const struct Ticket *ticket)
+{
+	if (checkIf24H(ticket->inputTime) && verifyIDNumber(ticket->idNum) && ticket->priority >= 1 && ticket->priority <= 6 &&
+		ticket->entryPoint >= 1 && ticket->entryPoint <= 2 && verifyDropOff(ticket->exitPoint, ticket->inputTime, ticket->entryPoint) && ticket->passName[0] != '\0')
+		return RESERVE_OK;
+	else
+		return RESERVE_INVALID;
+}
+
+/* SEAT STATE FUNCTIONS */
+/* Returns the vehicle layout with the given index */
+const struct Layout *getLayout(int layoutType)
+{
+	return &layoutTable[layoutType];
+}
+/* Changes the seat layout of a bus along with its load limit */
+void setLayout(struct Bus *fleet, int ctrBus, int layoutType)
+{
+	fleet[ctrBus].layoutType = layoutType;
+	fleet[ctrBus].limitType = layoutTable[layoutType].capacity;
+}
+/* Returns 1 if a bus can be converted into a larger layout within its maximum load limit, otherwise 0 */
+int checkConvertible(const struct Bus *fleet, int ctrBus)
+{
+	int nextLayout = layoutTable[fleet[ctrBus].layoutType].convertsTo;
+	return nextLayout >= 0 && layoutTable[nextLayout].capacity <= fleet[ctrBus].maxLimit;
+}
+/* Returns the load limit of a bus after every conversion it is allowed to go through */
+int getFullCapacity(const struct Bus *fleet, int ctrBus)
+{
+	int layoutType = fleet[ctrBus].layoutType;
+
+	while (layoutTable[layoutType].convertsTo >= 0 && layoutTable[layoutTable[layoutType].convertsTo].capacity <= fleet[ctrBus].maxLimit)
+		layoutType = layoutTable[layoutType].convertsTo;
+
+	return layoutTable[layoutType].capacity;
+}
+/* Returns 1 if the given seat of a bus is occupied, otherwise 0 */
+int checkSeat(const struct Bus *fleet, int ctrBus, int ctrSeat)
+{
+	return (fleet[ctrBus].seatMask >> ctrSeat) & 1UL;
+}
+/* Returns 1 if the given seat of a bus holds a passenger who can be moved to a later trip, otherwise 0. Members of a group travel together and are never moved. */
+static int checkMovable(const struct Bus *fleet, int ctrBus, int ctrSeat)
+{
+	return checkSeat(fleet, ctrBus, ctrSeat) && fleet[ctrBus].load[ctrSeat].groupNum < 0;
+}
+/* Returns the number of occupied seats in a seat mask */
+int countSeats(unsigned long seatMask)
+{
+	int ctrUsed = 0;
+	while (seatMask != 0)
+	{
+		seatMask &= seatMask - 1;	// clears the lowest occupied seat
+		ctrUsed++;
+	}
+	return ctrUsed;
+}
+/* Returns the index of the first vacant seat within the first localLimit seats of a seat mask, or -1 if all of them are occupied */
+int findVacantSeat(unsigned long seatMask, int localLimit)
+{
+	unsigned long vacantMask = ~seatMask & ((1UL << localLimit) - 1);
+	int ctrSeat = 0;
+
+	if (vacantMask == 0)
+		return -1;
+
+	vacantMask &= ~vacantMask + 1;	// keeps only the lowest vacant seat
+	while (vacantMask >>= 1)
+		ctrSeat++;
+	return ctrSeat;
+}
+/* Returns the current load of a bus. See documentation below for different return modes. */
+int checkBusLoad(const struct Bus *fleet, int ctrBus, int returnMode)
+{
+	int localLimit = fleet[ctrBus].limitType;
+	int ctrUsed = countSeats(fleet[ctrBus].seatMask & ((1UL << localLimit) - 1));	// number of occupied seats on a bus
+	int ctrVacant = findVacantSeat(fleet[ctrBus].seatMask, localLimit);				// lowest index that contains a vacant seat
+
+	//printf("AE%d: (%d/%d)\n", fleet[ctrBus].busNum, ctrUsed, fleet[ctrBus].limitType);
+	switch (returnMode)
+	{
+		case 1:						// MODE 1: returns only the number of passenger onboard
+			return ctrUsed;
+			break;
+		case 2:						// MODE 2: returns only whether a bus is full or not in this mode
+			if (ctrUsed < localLimit)
+				return 0;			// returns 0 if the bus has vacant seats
+			else if (checkConvertible(fleet, ctrBus))
+				return -1; 			// returns -1 if the bus is full but can be converted into a larger layout
+			else
+				return -2; 			// returns -2 if the bus is full and cannot be converted
+			break;
+		case 3:						// MODE 3: returns the index of a vacant seat on the bus, or -1 if the bus is full
+			return ctrVacant;
+			break;
+	}
+
+	return -1;
+}
+/* Adds the number of passengers onboard a bus for each drop-off point to the dropOffs[] array, which follows the order of the codes[] array */
+void countBusDropOffs(const struct Bus *fleet, int ctrBus, int *dropOffs)
+{
+	int ctrLoad, verifyCode;
+
+	for (ctrLoad = 0; ctrLoad < fleet[ctrBus].limitType; ctrLoad++)
+	{
+		if (checkSeat(fleet, ctrBus, ctrLoad))
+		{
+			switch (fleet[ctrBus].busNum)
+			{
+				case 108:
+				case 109:
+					verifyCode = verifyDropOff(fleet[ctrBus].load[ctrLoad].exitPoint, fleet[ctrBus].load[ctrLoad].inputTime, fleet[ctrBus].load[ctrLoad].entryPoint) - 1; // only AE108 and AE109 need the input time to verify drop-off point code 104
+					break;
+				default:
+					verifyCode = verifyDropOff(fleet[ctrBus].load[ctrLoad].exitPoint, -1, fleet[ctrBus].load[ctrLoad].entryPoint) - 1;
+					break;
+			}
+
+			if (verifyCode >= 0)	// verifyDropOff returns the index + 1 of the drop-off code
+				dropOffs[verifyCode]++;
+		}
+	}
+}
+
+/* ALLOCATION FUNCTIONS */
+/* Inserts initial values in all bus units using the active bus schedule */
+void initializeBus(struct Bus *fleet)
+{
+	int ctrFleet, ctrUnit;
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		fleet[ctrFleet].busNum = busSchedule[ctrFleet][0];
+		fleet[ctrFleet].busTime = busSchedule[ctrFleet][1];
+		setLayout(fleet, ctrFleet, busSchedule[ctrFleet][2]);
+		fleet[ctrFleet].seatMask = 0;							// all seats start vacant
+		fleet[ctrFleet].maxLimit = SEAT_LIMIT;					// all buses can be converted into any larger layout listed in the layout table
+		for (ctrUnit = 0; ctrUnit < SEAT_LIMIT; ctrUnit++)		// all loads arrays can fit the largest layout, but the system will limit the number of passengers to the capacity of the current layout
+		{
+			fleet[ctrFleet].load[ctrUnit].busNum = 0;
+			fleet[ctrFleet].load[ctrUnit].exitPoint = 0;
+		}
+	}
+}
+/* Seats a passenger on a specific seat of a bus */
+static void assignToSeat(struct Bus *fleet, struct Ticket *p, int ctrBus, int ctrSeat, int ctrTicket)
+{
+	p[ctrTicket].busNum = fleet[ctrBus].busNum;		 // assigns passenger's bus number with bus number
+	fleet[ctrBus].load[ctrSeat] = p[ctrTicket];		 // assigns passenger to the bus load at that index
+	fleet[ctrBus].load[ctrSeat].origNum = ctrTicket; // saves the passenger number to their info card
+	fleet[ctrBus].seatMask |= 1UL << ctrSeat;		 // marks the seat as occupied
+}
+/* Gets the lowest leveled passenger onboard a full bus and swaps them with the incoming passenger if the incoming passenger has a higher priority. Returns the ticket index of the outgoing passenger to be reprocessed into the system, or -1 if nobody was moved. */
+static int priorityManager(struct Bus *fleet, struct Ticket *p, int ctrTicket, int ctrFindBus, int *ctrSeat)
+{
+	int localLimit = fleet[ctrFindBus].limitType;		// current bus capacity
+	int lowestIndex = -1;		// stores the index of the lowest priority leveled passenger
+	int ctrLoad;				// counter for getting the lowest priority leveled passenger
+	int ctrOut;					// ticket index of the outgoing passenger
+
+	for (ctrLoad = 0; ctrLoad < localLimit; ctrLoad++)		// get lowest priority leveled passenger
+	{
+		if (!checkMovable(fleet, ctrFindBus, ctrLoad))
+			continue;
+		if (lowestIndex < 0 || fleet[ctrFindBus].load[ctrLoad].priority > fleet[ctrFindBus].load[lowestIndex].priority)
+			lowestIndex = ctrLoad;
+	}
+
+	if (lowestIndex >= 0 && fleet[ctrFindBus].load[lowestIndex].priority > p[ctrTicket].priority) // compares the incoming passenger with the lowest priority passenger
+	{
+		ctrOut = fleet[ctrFindBus].load[lowestIndex].origNum;
+		assignToSeat(fleet, p, ctrFindBus, lowestIndex, ctrTicket);
+		*ctrSeat = lowestIndex;
+		return ctrOut;
+	}
+	else
+		return -1;
+}
+/* Looks for an available bus schedule given the input time and seats the passenger. A passenger moved out by a higher priority passenger keeps looking from the next bus onwards. */
+int findMatchingTime(struct Bus *fleet, struct Ticket *p, int ctrTicket, struct Reservation *result)
+{
+	int ctrCurrent = ctrTicket;		// ticket index of the passenger currently looking for a seat
+	int ctrFindBus, ctrSeat, ctrOut;
+	int tripFound = 0;				// set once the requested passenger has a compatible schedule
+	long long searchStart, stepStart;	// start times of the traced steps
+
+	result->status = RESERVE_NO_TRIP;
+	result->ticketNum = ctrTicket;
+	result->busIndex = -1;
+	result->busNum = 0;
+	result->busTime = 0;
+	result->seatNum = -1;
+	result->ctrConverted = 0;
+	result->ctrDisplaced = 0;
+	result->unservedNum = -1;
+
+	for (ctrFindBus = 0; ctrFindBus < FLEET_LIMIT; ctrFindBus++)
+	{
+		if (checkRoute(fleet[ctrFindBus].busNum, p[ctrCurrent].entryPoint) && p[ctrCurrent].inputTime < fleet[ctrFindBus].busTime) 	// checks for a bus schedule compatible with the passenger's input time
+		{
+			searchStart = beginTrace();
+			if (ctrCurrent == ctrTicket)
+				tripFound = 1;
+
+			if (checkBusLoad(fleet, ctrFindBus, 2) == -1)
+			{
+				stepStart = beginTrace();
+				setLayout(fleet, ctrFindBus, layoutTable[fleet[ctrFindBus].layoutType].convertsTo);
+				result->ctrConverted++;
+				endTrace("convertLayout", ctrCurrent, fleet[ctrFindBus].busNum, stepStart);
+			}
+
+			ctrSeat = checkBusLoad(fleet, ctrFindBus, 3);
+			if (ctrSeat >= 0)
+			{
+				assignToSeat(fleet, p, ctrFindBus, ctrSeat, ctrCurrent);
+				ctrOut = -1;
+			}
+			else
+			{
+				stepStart = beginTrace();
+				ctrOut = priorityManager(fleet, p, ctrCurrent, ctrFindBus, &ctrSeat);
+				endTrace("priorityManager", ctrCurrent, fleet[ctrFindBus].busNum, stepStart);
+			}
+			endTrace("findMatchingTime", ctrCurrent, fleet[ctrFindBus].busNum, searchStart);
+
+			if (ctrSeat >= 0 && ctrCurrent == ctrTicket)
+			{
+				result->status = RESERVE_OK;
+				result->busIndex = ctrFindBus;
+				result->busNum = fleet[ctrFindBus].busNum;
+				result->busTime = fleet[ctrFindBus].busTime;
+				result->seatNum = ctrSeat;
+			}
+
+			if (ctrSeat >= 0 && ctrOut < 0)
+				return result->busIndex;	// returns the bus index of the requested passenger once nobody else needs a seat
+
+			if (ctrOut >= 0)				// sets the removed passenger back into the loop
+			{
+				result->ctrDisplaced++;
+				ctrCurrent = ctrOut;
+			}
+		}
+	}
+
+	if (ctrCurrent != ctrTicket)			// a moved passenger ran out of trips
+	{
+		p[ctrCurrent].busNum = 0;
+		result->unservedNum = ctrCurrent;
+	}
+	else if (tripFound)
+		result->status = RESERVE_NO_SEAT;
+
+	return result->busIndex;
+}
+
+/* FILE FUNCTIONS */
+/* Generates a file name given a date */
+void generateTripFileName (string *fileName, int currentDate)
+{
+	int month = currentDate / 1000000;
+	int day = (currentDate / 10000) % 100;
+	int year = currentDate % 10000;
+	string tempStr;
+
+	strcpy(*fileName, "Trip-");
+
+	if (day < 10)
+		strcat(*fileName, "0");
+
+	snprintf(tempStr, sizeof(day), "%d", day);
+	strcat(*fileName, tempStr);
+	strcat(*fileName, "-");
+
+	if (month < 10)
+		strcat(*fileName, "0");
+	snprintf(tempStr, sizeof(month), "%d", month);
+	strcat(*fileName, tempStr);
+	strcat(*fileName, "-");
+
+	snprintf(tempStr, sizeof(year) + 1, "%d", year);
+	strcat(*fileName, tempStr);
+	strcat(*fileName, ".txt");
+}
+/* Checks if the file name is a trip file name, since "0" is passed when nothing should be saved */
+static int checkTripFileName(string fileName)
+{
+	return strncmp(fileName, "Trip", 4) == 0;
+}
+/* Writes the lines of one ticket record, from the route to the drop-off code */
+static void writeTripRecord(FILE *destPtr, const struct Bus *fleet, const struct Ticket *p, int ctrBus, int ctrTicket, int ctrSeat)
+{
+	switch (p[ctrTicket].entryPoint) // write embarkation point to file
+	{
+		case 1:
+			fprintf(destPtr, "Manila\n");
+			break;
+		case 2:
+			fprintf(destPtr, "Laguna\n");
+			break;
+	}
+
+	fprintf(destPtr, "%s\n", p[ctrTicket].passName);
+	fprintf(destPtr, "%d\n%d\n%d\n%d\n%d\n%d\n%d\n", p[ctrTicket].idNum, p[ctrTicket].priority, p[ctrTicket].inputTime, fleet[ctrBus].busNum, fleet[ctrBus].limitType, ctrSeat, p[ctrTicket].exitPoint); // write passenger name to file
+}
+/* Saves passenger structs to a text file. Returns 1 if the record was written, otherwise 0. */
+static int saveToTripFile(struct Bus *fleet, struct Ticket *p, int ctrBus, int ctrTicket, int ctrSeat, string fileName)
+{
+	FILE *destPtr;
+
+	if (!checkTripFileName(fileName) || p[ctrTicket].entryPoint < 1 || p[ctrTicket].entryPoint > 2)
+		return 0;
+
+	destPtr = fopen(fileName, "a+");
+	if (destPtr == NULL)
+		return 0;
+
+	fprintf(destPtr, "\n");
+	writeTripRecord(destPtr, fleet, p, ctrBus, ctrTicket, ctrSeat);
+
+	fclose(destPtr);
+	return 1;
+}
+/* Saves every member of a group booking as a single group record in a text file. Returns 1 if the record was written, otherwise 0. */
+static int saveGroupToTripFile(const struct Bus *fleet, const struct Ticket *p, int ctrBus, int firstTicket, int groupSize, const int *seats, string fileName)
+{
+	FILE *destPtr;
+	int ctrMember;
+
+	if (!checkTripFileName(fileName))
+		return 0;
+
+	destPtr = fopen(fileName, "a+");
+	if (destPtr == NULL)
+		return 0;
+
+	fprintf(destPtr, "\nGroup\n%d\n", groupSize);		// the member records follow without blank lines in between
+	for (ctrMember = 0; ctrMember < groupSize; ctrMember++)
+		writeTripRecord(destPtr, fleet, p, ctrBus, firstTicket + ctrMember, seats[ctrMember]);
+
+	fclose(destPtr);
+	return 1;
+}
+/* Saves a cancellation record to a text file. Returns 1 if the record was written, otherwise 0. */
+static int saveCancelToTripFile(int ctrTicket, string fileName)
+{
+	FILE *destPtr;
+
+	if (!checkTripFileName(fileName))
+		return 0;
+
+	destPtr = fopen(fileName, "a+");
+	if (destPtr == NULL)
+		return 0;
+
+	fprintf(destPtr, "\nCancel\n%d\n", ctrTicket);
+	fclose(destPtr);
+	return 1;
+}
+/* Returns the next byte of a trip file, or EOF if the end of the file has been reached */
+static int readTripChar(struct TripReader *reader)
+{
+	int nextChar;
+
+	if (reader->ctrPos >= reader->ctrLen)		// refills the buffer once every byte in it has been read
+	{
+		reader->ctrLen = fread(reader->buffer, 1, READ_BUFFER_SIZE, reader->srcPtr);
+		reader->ctrPos = 0;
+		if (reader->ctrLen <= 0)
+			return EOF;
+	}
+
+	nextChar = (unsigned char) reader->buffer[reader->ctrPos++];
+	if (nextChar == '\n')
+		reader->lineNum++;
+
+	return nextChar;
+}
+/* Skips empty lines and returns the first byte of the next record, or EOF if there are no more records */
+static int skipTripBlankLines(struct TripReader *reader)
+{
+	int nextChar;
+
+	do
+		nextChar = readTripChar(reader);
+	while (nextChar == '\n' || nextChar == '\r' || nextChar == ' ' || nextChar == '\t');
+
+	return nextChar;
+}
+/* Copies the rest of the current line into the destination string, dropping any characters that do not fit. Returns 0 if the end of the file was reached first. */
+static int readTripLine(struct TripReader *reader, char *destStr, int maxLen)
+{
+	int nextChar, ctrChar = 0;
+
+	nextChar = readTripChar(reader);
+	while (nextChar != '\n' && nextChar != EOF)
+	{
+		if (nextChar != '\r' && ctrChar < maxLen - 1)
+			destStr[ctrChar++] = nextChar;
+		nextChar = readTripChar(reader);
+	}
+	destStr[ctrChar] = '\0';
+
+	return nextChar != EOF || ctrChar > 0;
+}
+/* Reads a line that holds a single integer. Returns 1 if valid, otherwise 0. */
+static int readTripInt(struct TripReader *reader, int *inputDir)
+{
+	int nextChar, inputTemp = 0, ctrDigits = 0, isNegative = 0;
+
+	nextChar = readTripChar(reader);
+	while (nextChar == ' ' || nextChar == '\t')
+		nextChar = readTripChar(reader);
+
+	if (nextChar == '-')
+	{
+		isNegative = 1;
+		nextChar = readTripChar(reader);
+	}
+
+	while (nextChar >= '0' && nextChar <= '9')
+	{
+		inputTemp = inputTemp * 10 + (nextChar - '0');
+		ctrDigits++;
+		nextChar = readTripChar(reader);
+	}
+
+	while (nextChar == ' ' || nextChar == '\t' || nextChar == '\r')
+		nextChar = readTripChar(reader);
+
+	if (ctrDigits == 0 || (nextChar != '\n' && nextChar != EOF))
+		return 0;
+
+	*inputDir = isNegative ? -inputTemp : inputTemp;
+	return 1;
+}
+/* Reads the lines of one ticket record that starts with the given byte, from the route to the drop-off code. Returns 1 if valid, otherwise 0. */
+static int readTripRecord(struct TripReader *reader, struct Ticket *ticket, int firstChar, int *recordLine)
+{
+	int dumpInt, ctrField, isValid = 1;
+	int *fieldDir[7];					// destination of each integer field of a record, in file order
+
+	switch (firstChar)
+	{
+		case 'M':
+		case 'm':
+			ticket->entryPoint = 1;
+			break;
+		case 'l':
+		case 'L':
+			ticket->entryPoint = 2;
+			break;
+		default:
+			isValid = 0;
+			break;
+	}
+
+	fieldDir[0] = &ticket->idNum;			// store ID number
+	fieldDir[1] = &ticket->priority;		// store priority number
+	fieldDir[2] = &ticket->inputTime;		// store time of input
+	fieldDir[3] = &dumpInt;					// skip bus number
+	fieldDir[4] = &dumpInt;					// skip bus configuration
+	fieldDir[5] = &dumpInt;					// skip bus seat index
+	fieldDir[6] = &ticket->exitPoint;		// store drop off code
+
+	if (isValid)
+		isValid = readTripLine(reader, ticket->passName, sizeof(string)) && 	// skip the rest of the route name
+				  readTripLine(reader, ticket->passName, sizeof(string));		// get name with spaces
+
+	for (ctrField = 0; ctrField < 7 && isValid; ctrField++)
+	{
+		*recordLine = reader->lineNum;
+		isValid = readTripInt(reader, fieldDir[ctrField]);
+	}
+
+	return isValid;
+}
+/* Reads every record of an open trip file and reserves or cancels each ticket without saving anything. Returns the line number of the first malformed record, or 0 if every record was read. */
+int replayTripFile(FILE *srcPtr, struct Bus *fleet, struct Ticket *p, int currentDate, int *ctrTicket, int *ctrRoute)
+{
+	static struct TripReader reader;	// kept out of the stack because of the size of the buffer
+	struct Reservation result;
+	struct Ticket group[GROUP_LIMIT];
+	struct Reservation groupResults[GROUP_LIMIT];
+	int nextChar, recordLine, cancelNum, groupSize, ctrMember, isValid = 1;
+
+	reader.srcPtr = srcPtr;
+	reader.ctrPos = 0;
+	reader.ctrLen = 0;
+	reader.lineNum = 1;
+
+	while (isValid && *ctrTicket < DATABASE_LIMIT && (nextChar = skipTripBlankLines(&reader)) != EOF)
+	{
+		recordLine = reader.lineNum;
+
+		switch (nextChar)
+		{
+			case 'C':
+			case 'c':				// cancellation records only hold a ticket number
+				isValid = readTripLine(&reader, p[*ctrTicket].passName, sizeof(string));	// skip the rest of the record name
+				recordLine = reader.lineNum;
+				isValid = isValid && readTripInt(&reader, &cancelNum) && cancelNum >= 0 && cancelNum < *ctrTicket;
+
+				if (isValid)
+					cancelTicket(fleet, p, cancelNum, "0");
+				break;
+			case 'G':
+			case 'g':				// group records hold a member count followed by one ticket record for each member
+				isValid = readTripLine(&reader, p[*ctrTicket].passName, sizeof(string));	// skip the rest of the record name
+				recordLine = reader.lineNum;
+				isValid = isValid && readTripInt(&reader, &groupSize) && groupSize >= 1 && groupSize <= GROUP_LIMIT;
+
+				for (ctrMember = 0; ctrMember < groupSize && isValid; ctrMember++)
+				{
+					recordLine = reader.lineNum;
+					isValid = readTripRecord(&reader, &group[ctrMember], skipTripBlankLines(&reader), &recordLine);
+					group[ctrMember].inputDate = currentDate;
+				}
+
+				if (isValid && reserveGroup(fleet, p, ctrTicket, group, groupSize, "0", groupResults) == RESERVE_OK)	// assign seats but dont save to file
+					ctrRoute[group[0].entryPoint - 1] += groupSize;
+				break;
+			default:
+				isValid = readTripRecord(&reader, &p[*ctrTicket], nextChar, &recordLine);
+
+				if (isValid)
+				{
+					p[*ctrTicket].inputDate = currentDate;							// store date of input
+					if (reserveTicket(fleet, p, *ctrTicket, "0", &result) == RESERVE_OK)	// assign seat but dont save to file
+					{
+						ctrRoute[p[*ctrTicket].entryPoint - 1]++;
+						(*ctrTicket)++;											// ticket numbers follow the order of the reserved records in the file
+					}
+				}
+				break;
+		}
+	}
+
+	if (isValid)
+		return 0;
+	else
+		return recordLine;
+}
+/* Fills the system database with bus and passenger data from a date-specific text file. Returns -1 if a new file was created, 0 if every record was loaded, or the line number of the first malformed record. */
+int loadTripFile(struct Bus *fleet, struct Ticket *p, int currentDate, int *ctrTicket, int *ctrRoute)
+{
+	string fileName;
+	int errorLine;
+	long long replayStart;
+	generateTripFileName(&fileName, currentDate);
+	FILE *srcPtr = fopen(fileName, "r");
+
+	if (srcPtr == NULL)
+	{
+		srcPtr = fopen(fileName, "w");
+		if (srcPtr != NULL)
+			fclose(srcPtr);
+		return -1;
+	}
+
+	replayStart = beginTrace();
+	errorLine = replayTripFile(srcPtr, fleet, p, currentDate, ctrTicket, ctrRoute);
+	endTrace("replayTripFile", -1, 0, replayStart);
+	fclose(srcPtr);
+	return errorLine;
+}
+/* Writes the load of every bus to a date-specific status file that other programs can poll. The file starts with "SEQ n" and ends with "END n", so a reader that sees different numbers, or no END line, has caught it mid-write and must read it again. */
+void publishFleetStatus(const struct Bus *fleet, int currentDate)
+{
+	static int ctrPublish = 0;		// sequence number of the last published status
+	string fileName, statusName;
+	int dropOffs[ROUTE_LIMIT];		// number of passengers for each drop-off point
+	int ctrFleet, ctrList;
+	FILE *destPtr;
+
+	generateTripFileName(&fileName, currentDate);
+	strcpy(statusName, "Fleet");
+	strcat(statusName, fileName + 4);	// replaces "Trip" with "Fleet" in the file name
+
+	destPtr = fopen(statusName, "w");
+	if (destPtr != NULL)
+	{
+		ctrPublish++;
+		fprintf(destPtr, "SEQ %d\nDATE %08d\n", ctrPublish, currentDate);
+
+		for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+		{
+			for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)
+				dropOffs[ctrList] = 0;
+			countBusDropOffs(fleet, ctrFleet, dropOffs);
+
+			// BUS <bus number> <departure time> <limit type> <passengers> <drop-off counts in route order>
+			fprintf(destPtr, "BUS %d %d %d %d", fleet[ctrFleet].busNum, fleet[ctrFleet].busTime, fleet[ctrFleet].limitType, checkBusLoad(fleet, ctrFleet, 1));
+			for (ctrList = 0; ctrList < 5; ctrList++)
+				fprintf(destPtr, " %d", dropOffs[ctrList] + dropOffs[ctrList + 5]);	// a bus only has passengers for the five drop-off points of its own route
+			fprintf(destPtr, "\n");
+		}
+
+		fprintf(destPtr, "END %d\n", ctrPublish);
+		fclose(destPtr);
+	}
+}
+/* Generates the name of the standby copy of a trip file given a date */
+static void generateStandbyFileName(string *fileName, int currentDate)
+{
+	string tripName;
+
+	generateTripFileName(&tripName, currentDate);
+	strcpy(*fileName, STANDBY_DIRECTORY);
+	strcat(*fileName, tripName);
+}
+/* Appends every byte of the source file from startPos onwards to the destination file. Returns the number of bytes copied, or -1 if a write failed. */
+static long copyFileTail(FILE *srcPtr, FILE *destPtr, long startPos)
+{
+	char buffer[4096];
+	long ctrCopied = 0;
+	size_t ctrRead;
+
+	fseek(srcPtr, startPos, SEEK_SET);
+	while ((ctrRead = fread(buffer, 1, sizeof(buffer), srcPtr)) > 0)
+	{
+		if (fwrite(buffer, 1, ctrRead, destPtr) != ctrRead)
+			return -1;
+		ctrCopied += ctrRead;
+	}
+
+	if (fflush(destPtr) != 0)
+		return -1;
+	return ctrCopied;
+}
+/* Sends the records of the trip file that the standby copy does not have yet. Since trip files are only ever appended to, the size of the standby copy tells which records it has already received. Returns the number of bytes sent, or -1 if the standby copy could not be reached or no longer matches the trip file. */
+long shipTripFile(int currentDate)
+{
+	string fileName, standbyName;
+	FILE *srcPtr, *destPtr;
+	long tripSize, standbySize, ctrCopied = -1;
+
+	generateTripFileName(&fileName, currentDate);
+	generateStandbyFileName(&standbyName, currentDate);
+
+	srcPtr = fopen(fileName, "rb");
+	if (srcPtr == NULL)
+		return -1;
+
+	destPtr = fopen(standbyName, "ab");
+	if (destPtr != NULL)
+	{
+		fseek(srcPtr, 0, SEEK_END);
+		tripSize = ftell(srcPtr);
+		fseek(destPtr, 0, SEEK_END);
+		standbySize = ftell(destPtr);		// acknowledged position of the standby copy
+
+		if (standbySize <= tripSize)
+			ctrCopied = copyFileTail(srcPtr, destPtr, standbySize);
+
+		fclose(destPtr);
+	}
+
+	fclose(srcPtr);
+	return ctrCopied;
+}
+/* Recreates a missing trip file from its standby copy. Returns 1 if the trip file was restored, otherwise 0. */
+int restoreTripFile(int currentDate)
+{
+	string fileName, standbyName;
+	FILE *srcPtr, *destPtr;
+	int isRestored = 0;
+
+	generateTripFileName(&fileName, currentDate);
+	generateStandbyFileName(&standbyName, currentDate);
+
+	destPtr = fopen(fileName, "rb");
+	if (destPtr != NULL)				// only restores if the trip file is missing
+	{
+		fclose(destPtr);
+		return 0;
+	}
+
+	srcPtr = fopen(standbyName, "rb");
+	if (srcPtr != NULL)
+	{
+		destPtr = fopen(fileName, "wb");
+		if (destPtr != NULL)
+		{
+			isRestored = copyFileTail(srcPtr, destPtr, 0) >= 0;
+			fclose(destPtr);
+		}
+		fclose(srcPtr);
+	}
+
+	return isRestored;
+}
+/* Returns the size of a file in bytes, or -1 if it cannot be opened */
+long getFileSize(string fileName)
+{
+	FILE *srcPtr = fopen(fileName, "rb");
+	long fileSize = -1;
+
+	if (srcPtr != NULL)
+	{
+		fseek(srcPtr, 0, SEEK_END);
+		fileSize = ftell(srcPtr);
+		fclose(srcPtr);
+	}
+
+	return fileSize;
+}
+/* Creates the snapshot file name for the given date */
+void generateSnapshotFileName(string *fileName, int currentDate)
+{
+	string tripName;
+
+	generateTripFileName(&tripName, currentDate);
+	strcpy(*fileName, "Snapshot");
+	strcat(*fileName, tripName + 4);					// replaces "Trip" with "Snapshot" in the file name
+	strcpy(*fileName + strlen(*fileName) - 4, ".bin");	// replaces ".txt" since the snapshot is a binary file
+}
+/* Writes the fleet to the snapshot file along with the size of the trip file it matches. Returns 0 if successful, otherwise -1. */
+int saveSnapshot(const struct Bus *fleet, int currentDate)
+{
+	struct SnapshotHeader header;
+	string fileName, snapshotName, tempName;
+	FILE *destPtr;
+	int isWritten = 0;
+
+	generateTripFileName(&fileName, currentDate);
+	generateSnapshotFileName(&snapshotName, currentDate);
+	strcpy(tempName, snapshotName);
+	strcat(tempName, ".tmp");
+
+	memset(&header, 0, sizeof(header));
+	strcpy(header.magic, "AESNAP1");
+	header.currentDate = currentDate;
+	header.busSize = sizeof(struct Bus);
+	header.tripSize = getFileSize(fileName);
+
+	destPtr = fopen(tempName, "wb");
+	if (destPtr != NULL)
+	{
+		isWritten = fwrite(&header, sizeof(header), 1, destPtr) == 1 && fwrite(fleet, sizeof(struct Bus), FLEET_LIMIT, destPtr) == FLEET_LIMIT;
+		isWritten = fclose(destPtr) == 0 && isWritten;
+	}
+
+	if (isWritten)
+	{
+		remove(snapshotName);			// readers that find no snapshot replay the trip file instead
+		isWritten = rename(tempName, snapshotName) == 0;
+	}
+	else
+		remove(tempName);
+
+	return isWritten ? 0 : -1;
+}
+/* Fills the fleet from the snapshot file if it matches the trip file, otherwise replays the trip file without writing to it. Returns 1 if the snapshot was used, otherwise 0. */
+int loadSnapshot(struct Bus *fleet, int currentDate)
+{
+	static struct Ticket p[DATABASE_LIMIT];		// kept out of the stack because of its size
+	struct SnapshotHeader header;
+	string fileName, snapshotName;
+	int ctrTicket = 0, ctrRoute[2] = {0, 0}, isLoaded = 0;
+	FILE *srcPtr;
+
+	generateTripFileName(&fileName, currentDate);
+	generateSnapshotFileName(&snapshotName, currentDate);
+
+	srcPtr = fopen(snapshotName, "rb");
+	if (srcPtr != NULL)
+	{
+		isLoaded = fread(&header, sizeof(header), 1, srcPtr) == 1 && strcmp(header.magic, "AESNAP1") == 0 && header.currentDate == currentDate &&
+				   header.busSize == sizeof(struct Bus) && header.tripSize == getFileSize(fileName) && fread(fleet, sizeof(struct Bus), FLEET_LIMIT, srcPtr) == FLEET_LIMIT;
+		fclose(srcPtr);
+	}
+
+	if (!isLoaded)					// the snapshot is missing or older than the trip file
+	{
+		if (loadSchedule(fleet, SCHEDULE_FILE) != SCHEDULE_OK)
+			initializeBus(fleet);
+		srcPtr = fopen(fileName, "r");
+		if (srcPtr != NULL)
+		{
+			replayTripFile(srcPtr, fleet, p, currentDate, &ctrTicket, ctrRoute);
+			fclose(srcPtr);
+		}
+	}
+
+	return isLoaded;
+}
+
+/* ENGINE INTERFACE */
+/* Validates a ticket that has been filled in at p[ctrTicket], seats the passenger and saves the ticket to the trip file. Returns the status stored in the result. */
+int reserveTicket(struct Bus *fleet, struct Ticket *p, int ctrTicket, string fileName, struct Reservation *result)
+{
+	long long reserveStart = beginTrace(), stepStart = beginTrace();
+	int isValid = ctrTicket >= 0 && ctrTicket < DATABASE_LIMIT && validateTicket(&p[ctrTicket]) == RESERVE_OK;
+
+	endTrace("validateTicket", ctrTicket, 0, stepStart);
+	if (!isValid)
+	{
+		result->status = RESERVE_INVALID;
+		result->ticketNum = ctrTicket;
+		result->busIndex = -1;
+		result->busNum = 0;
+		result->busTime = 0;
+		result->seatNum = -1;
+		result->ctrConverted = 0;
+		result->ctrDisplaced = 0;
+		result->unservedNum = -1;
+		endTrace("reserveTicket", ctrTicket, 0, reserveStart);
+		return result->status;
+	}
+
+	p[ctrTicket].origNum = ctrTicket;
+	p[ctrTicket].busNum = 0;
+	p[ctrTicket].groupNum = -1;
+	p[ctrTicket].isCancelled = 0;
+	findMatchingTime(fleet, p, ctrTicket, result);
+
+	if (result->status == RESERVE_OK)
+	{
+		stepStart = beginTrace();
+		if (saveToTripFile(fleet, p, result->busIndex, ctrTicket, result->seatNum, fileName))	// a replay writes nothing, so there is no step to record
+			endTrace("saveToTripFile", ctrTicket, result->busNum, stepStart);
+	}
+
+	endTrace("reserveTicket", ctrTicket, result->busNum, reserveStart);
+	return result->status;
+}
+/* Reserves a list of tickets in order. Each reserved ticket is added to p[] and takes the next ticket number. Returns the number of tickets reserved. */
+int reserveBatch(struct Bus *fleet, struct Ticket *p, int *ctrTicket, const struct Ticket *batch, int batchSize, string fileName, struct Reservation *results)
+{
+	int ctrBatch, ctrReserved = 0;
+
+	for (ctrBatch = 0; ctrBatch < batchSize; ctrBatch++)
+	{
+		if (*ctrTicket < DATABASE_LIMIT)
+		{
+			p[*ctrTicket] = batch[ctrBatch];
+			if (reserveTicket(fleet, p, *ctrTicket, fileName, &results[ctrBatch]) == RESERVE_OK)
+			{
+				(*ctrTicket)++;
+				ctrReserved++;
+			}
+		}
+		else
+		{
+			results[ctrBatch].status = RESERVE_INVALID;
+			results[ctrBatch].ticketNum = -1;
+			results[ctrBatch].busIndex = -1;
+			results[ctrBatch].busNum = 0;
+			results[ctrBatch].busTime = 0;
+			results[ctrBatch].seatNum = -1;
+			results[ctrBatch].ctrConverted = 0;
+			results[ctrBatch].ctrDisplaced = 0;
+			results[ctrBatch].unservedNum = -1;
+		}
+	}
+
+	return ctrReserved;
+}
+/* Picks seats for a group on a bus, preferring a run of vacant seats side by side in one row with no aisle between them, then a run in one row, then a run of consecutive seat numbers, then the lowest vacant seats. Returns 1 if every member has a seat, otherwise 0. */
+static int findGroupSeats(const struct Bus *fleet, int ctrBus, int groupSize, int *seats)
+{
+	const struct Layout *layout = getLayout(fleet[ctrBus].layoutType);
+	unsigned long seatMask = fleet[ctrBus].seatMask;
+	int localLimit = fleet[ctrBus].limitType;
+	int seatRow[SEAT_LIMIT], seatBlock[SEAT_LIMIT];	// row of each seat and block of seats between aisles in that row
+	int ctrRow, ctrColumn, ctrSeat = 0, ctrBlock = 0, ctrPass, ctrRun, ctrMember = 0;
+
+	for (ctrRow = 0; ctrRow < layout->ctrRows; ctrRow++)	// seats are numbered from the back row and left to right
+	{
+		for (ctrColumn = 0; ctrColumn < layout->ctrColumns && layout->rowPlan[ctrRow][ctrColumn] != '\0'; ctrColumn++)
+		{
+			if (layout->rowPlan[ctrRow][ctrColumn] == 'S' && ctrSeat < SEAT_LIMIT)
+			{
+				seatRow[ctrSeat] = ctrRow;
+				seatBlock[ctrSeat] = ctrBlock;
+				ctrSeat++;
+			}
+			else if (layout->rowPlan[ctrRow][ctrColumn] == 'A')
+				ctrBlock++;
+		}
+		ctrBlock++;
+	}
+
+	for (ctrPass = 0; ctrPass < 3; ctrPass++)		// 0 keeps the run in one block, 1 keeps it in one row, 2 takes any consecutive seats
+	{
+		ctrRun = 0;
+		for (ctrSeat = 0; ctrSeat < localLimit && ctrRun < groupSize; ctrSeat++)
+		{
+			if (seatMask & (1UL << ctrSeat))
+				ctrRun = 0;
+			else if (ctrRun > 0 && ((ctrPass == 0 && seatBlock[ctrSeat] != seatBlock[ctrSeat - 1]) || (ctrPass == 1 && seatRow[ctrSeat] != seatRow[ctrSeat - 1])))
+				ctrRun = 1;								// the run starts over past an aisle or at the next row
+			else
+				ctrRun++;
+		}
+
+		if (ctrRun == groupSize)
+		{
+			for (ctrMember = 0; ctrMember < groupSize; ctrMember++)
+				seats[ctrMember] = ctrSeat - groupSize + ctrMember;
+			return 1;
+		}
+	}
+
+	for (ctrSeat = 0; ctrSeat < localLimit && ctrMember < groupSize; ctrSeat++)	// otherwise takes the lowest vacant seats
+	{
+		if (!(seatMask & (1UL << ctrSeat)))
+			seats[ctrMember++] = ctrSeat;
+	}
+
+	return ctrMember == groupSize;
+}
+/* Seats every member of a group on the same departure without moving any other passenger, starting at ticket firstTicket of a passenger container that holds ticketLimit tickets.
+   Either every member is seated or none are. Fills seats[] and results[] for each member and returns RESERVE_OK, RESERVE_NO_TRIP, RESERVE_NO_SEAT or RESERVE_INVALID. */
+static int seatGroup(struct Bus *fleet, struct Ticket *p, int firstTicket, int ticketLimit, const struct Ticket *group, int groupSize, int *seats, struct Reservation *results)
+{
+	int ctrMember, ctrFindBus, ctrUsed, nextLayout, groupBus = -1, ctrConverted = 0, status = RESERVE_OK;
+	long long stepStart;
+
+	if (groupSize < 1 || groupSize > GROUP_LIMIT || firstTicket + groupSize > ticketLimit)
+		status = RESERVE_INVALID;
+
+	for (ctrMember = 0; ctrMember < groupSize && status == RESERVE_OK; ctrMember++)	// every member travels on the route and time of the first member
+	{
+		if (validateTicket(&group[ctrMember]) != RESERVE_OK || group[ctrMember].entryPoint != group[0].entryPoint || group[ctrMember].inputTime != group[0].inputTime)
+			status = RESERVE_INVALID;
+	}
+
+	if (status == RESERVE_OK)
+	{
+		status = RESERVE_NO_TRIP;
+		for (ctrFindBus = 0; ctrFindBus < FLEET_LIMIT && groupBus < 0; ctrFindBus++)
+		{
+			if (checkRoute(fleet[ctrFindBus].busNum, group[0].entryPoint) && group[0].inputTime < fleet[ctrFindBus].busTime)
+			{
+				status = RESERVE_NO_SEAT;
+				ctrUsed = checkBusLoad(fleet, ctrFindBus, 1);
+				nextLayout = layoutTable[fleet[ctrFindBus].layoutType].convertsTo;
+
+				if (fleet[ctrFindBus].limitType - ctrUsed < groupSize && checkConvertible(fleet, ctrFindBus) && layoutTable[nextLayout].capacity - ctrUsed >= groupSize)
+				{
+					stepStart = beginTrace();
+					setLayout(fleet, ctrFindBus, nextLayout);	// converts the bus early if that is what it takes to keep the group together
+					ctrConverted++;
+					endTrace("convertLayout", firstTicket, fleet[ctrFindBus].busNum, stepStart);
+				}
+
+				if (findGroupSeats(fleet, ctrFindBus, groupSize, seats))
+				{
+					groupBus = ctrFindBus;
+					status = RESERVE_OK;
+				}
+			}
+		}
+	}
+
+	for (ctrMember = 0; ctrMember < groupSize && ctrMember < GROUP_LIMIT; ctrMember++)
+	{
+		results[ctrMember].status = status;
+		results[ctrMember].ticketNum = status == RESERVE_OK ? firstTicket + ctrMember : -1;
+		results[ctrMember].busIndex = groupBus;
+		results[ctrMember].busNum = status == RESERVE_OK ? fleet[groupBus].busNum : 0;
+		results[ctrMember].busTime = status == RESERVE_OK ? fleet[groupBus].busTime : 0;
+		results[ctrMember].seatNum = status == RESERVE_OK ? seats[ctrMember] : -1;
+		results[ctrMember].ctrConverted = ctrMember == 0 ? ctrConverted : 0;
+		results[ctrMember].ctrDisplaced = 0;
+		results[ctrMember].unservedNum = -1;
+	}
+
+	if (status == RESERVE_OK)
+	{
+		for (ctrMember = 0; ctrMember < groupSize; ctrMember++)
+		{
+			p[firstTicket + ctrMember] = group[ctrMember];
+			p[firstTicket + ctrMember].origNum = firstTicket + ctrMember;
+			p[firstTicket + ctrMember].groupNum = firstTicket;
+			p[firstTicket + ctrMember].isCancelled = 0;
+			assignToSeat(fleet, p, groupBus, seats[ctrMember], firstTicket + ctrMember);
+		}
+	}
+
+	return status;
+}
+/* Seats every member of a group on the same departure without moving any other passenger, and saves the group as a single record in the trip file.
+   Either every member is seated or none are. Fills results[] for each member and returns RESERVE_OK, RESERVE_NO_TRIP, RESERVE_NO_SEAT or RESERVE_INVALID. */
+int reserveGroup(struct Bus *fleet, struct Ticket *p, int *ctrTicket, const struct Ticket *group, int groupSize, string fileName, struct Reservation *results)
+{
+	int seats[GROUP_LIMIT];
+	int status, firstTicket = *ctrTicket;
+	long long groupStart = beginTrace();
+
+	status = seatGroup(fleet, p, firstTicket, DATABASE_LIMIT, group, groupSize, seats, results);
+	if (status == RESERVE_OK)
+	{
+		*ctrTicket += groupSize;
+		saveGroupToTripFile(fleet, p, results[0].busIndex, firstTicket, groupSize, seats, fileName);
+	}
+
+	endTrace("reserveGroup", firstTicket, status == RESERVE_OK ? results[0].busNum : 0, groupStart);
+	return status;
+}
+/* Frees the seat of a reserved ticket and saves the cancellation to the trip file. Returns RESERVE_OK or RESERVE_NOT_FOUND. */
+int cancelTicket(struct Bus *fleet, struct Ticket *p, int ctrTicket, string fileName)
+{
+	int ctrFleet, ctrLoad;
+
+	if (ctrTicket < 0 || ctrTicket >= DATABASE_LIMIT || p[ctrTicket].busNum == 0)
+		return RESERVE_NOT_FOUND;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (fleet[ctrFleet].busNum == p[ctrTicket].busNum)
+		{
+			for (ctrLoad = 0; ctrLoad < fleet[ctrFleet].limitType; ctrLoad++)
+			{
+				if (checkSeat(fleet, ctrFleet, ctrLoad) && fleet[ctrFleet].load[ctrLoad].origNum == ctrTicket)
+				{
+					fleet[ctrFleet].seatMask &= ~(1UL << ctrLoad);	// marks the seat as vacant
+					fleet[ctrFleet].load[ctrLoad].busNum = 0;
+					fleet[ctrFleet].load[ctrLoad].exitPoint = 0;
+					p[ctrTicket].busNum = 0;
+					p[ctrTicket].isCancelled = 1;
+					saveCancelToTripFile(ctrTicket, fileName);
+					return RESERVE_OK;
+				}
+			}
+		}
+	}
+
+	return RESERVE_NOT_FOUND;
+}
+/* Fills the result with the schedule, load and drop-off counts of a bus. Returns the index of the bus in the fleet, or -1 if there is no such bus. */
+int queryBus(const struct Bus *fleet, int busNum, struct BusInfo *result)
+{
+	int ctrFleet, ctrList;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (fleet[ctrFleet].busNum == busNum)
+		{
+			result->busNum = fleet[ctrFleet].busNum;
+			result->busTime = fleet[ctrFleet].busTime;
+			result->limitType = fleet[ctrFleet].limitType;
+			result->ctrUsed = checkBusLoad(fleet, ctrFleet, 1);
+			for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)
+				result->dropOffs[ctrList] = 0;
+			countBusDropOffs(fleet, ctrFleet, result->dropOffs);
+			return ctrFleet;
+		}
+	}
+
+	return -1;
+}
+/* Fills the dropOffs[] array with the number of passengers for each drop-off point across the whole fleet */
+void queryDropOffs(const struct Bus *fleet, int *dropOffs)
+{
+	int ctrFleet, ctrList;
+
+	for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)
+		dropOffs[ctrList] = 0;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+		countBusDropOffs(fleet, ctrFleet, dropOffs);
+}
+/* Fills the result with the vacant seats and the seats held by each priority level that can be freed, and the seats held by groups, on the departures of a route after startTime and up to endTime, the same departures a passenger booking at startTime can board */
+void queryAvailability(const struct Bus *fleet, int entryPoint, int startTime, int endTime, struct Availability *result)
+{
+	int ctrFleet, ctrLoad, ctrList;
+
+	result->ctrTrips = 0;
+	result->ctrFree = 0;
+	result->ctrGrouped = 0;
+	for (ctrList = 0; ctrList < 6; ctrList++)
+		result->ctrPriority[ctrList] = 0;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (checkRoute(fleet[ctrFleet].busNum, entryPoint) && fleet[ctrFleet].busTime > startTime && fleet[ctrFleet].busTime <= endTime)
+		{
+			result->ctrTrips++;
+			result->ctrFree += getFullCapacity(fleet, ctrFleet) - checkBusLoad(fleet, ctrFleet, 1);	// a full bus is converted before it turns anyone away
+
+			for (ctrLoad = 0; ctrLoad < fleet[ctrFleet].limitType; ctrLoad++)
+			{
+				if (checkMovable(fleet, ctrFleet, ctrLoad) && fleet[ctrFleet].load[ctrLoad].priority >= 1 && fleet[ctrFleet].load[ctrLoad].priority <= 6)
+					result->ctrPriority[fleet[ctrFleet].load[ctrLoad].priority - 1]++;
+				else if (checkSeat(fleet, ctrFleet, ctrLoad) && fleet[ctrFleet].load[ctrLoad].groupNum >= 0)
+					result->ctrGrouped++;
+			}
+		}
+	}
+}
+/* Returns the index of the earliest bus of a route leaving after inputTime that a passenger of the given priority level can board, either on a vacant seat or by moving a lower priority passenger who was booked alone, or -1 if there is none */
+int findEarliestSeat(const struct Bus *fleet, int entryPoint, int inputTime, int priority)
+{
+	int ctrFleet, ctrLoad, earliestIndex = -1;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (checkRoute(fleet[ctrFleet].busNum, entryPoint) && inputTime < fleet[ctrFleet].busTime &&
+			(earliestIndex < 0 || fleet[ctrFleet].busTime < fleet[earliestIndex].busTime))
+		{
+			if (checkBusLoad(fleet, ctrFleet, 1) < getFullCapacity(fleet, ctrFleet))
+				earliestIndex = ctrFleet;
+			else
+			{
+				for (ctrLoad = 0; ctrLoad < fleet[ctrFleet].limitType; ctrLoad++)
+				{
+					if (checkMovable(fleet, ctrFleet, ctrLoad) && fleet[ctrFleet].load[ctrLoad].priority > priority)
+						earliestIndex = ctrFleet;
+				}
+			}
+		}
+	}
+
+	return earliestIndex;
+}
+
+/* SCHEDULE FUNCTIONS */
+/* Reads a schedule file with one "<bus number> <departure time> <seats>" line for each bus into a schedule table sorted by route and departure time.
+   The fleet is fixed: the file must list each of the FLEET_LIMIT buses that checkRoute knows exactly once, so a reload can retime a trip or change its vehicle but cannot add or remove one.
+   Returns SCHEDULE_OK, SCHEDULE_MISSING, or the line number of the first invalid line. */
+int readScheduleFile(string fileName, int schedule[][3])
+{
+	FILE *srcPtr = fopen(fileName, "r");
+	string line;
+	int lineNum = 0, ctrSchedule = 0, ctrList, ctrSort, busNum, busTime, capacity, layoutType, isValid = 1;
+	int temp[3];
+
+	if (srcPtr == NULL)
+		return SCHEDULE_MISSING;
+
+	while (isValid && fgets(line, sizeof(string), srcPtr) != NULL)
+	{
+		lineNum++;
+		if (sscanf(line, "%d", &busNum) != 1)	// skips blank lines
+			continue;
+
+		isValid = sscanf(line, "%d %d %d", &busNum, &busTime, &capacity) == 3 && ctrSchedule < FLEET_LIMIT &&
+				  (checkRoute(busNum, 1) || checkRoute(busNum, 2)) && checkIf24H(busTime);
+
+		for (ctrList = 0; ctrList < ctrSchedule && isValid; ctrList++)	// every bus is listed only once
+			isValid = schedule[ctrList][0] != busNum;
+
+		layoutType = -1;
+		for (ctrList = 0; ctrList < LAYOUT_LIMIT && isValid; ctrList++)
+		{
+			if (layoutTable[ctrList].capacity == capacity)
+				layoutType = ctrList;
+		}
+
+		if (isValid && layoutType >= 0)
+		{
+			schedule[ctrSchedule][0] = busNum;
+			schedule[ctrSchedule][1] = busTime;
+			schedule[ctrSchedule][2] = layoutType;
+			ctrSchedule++;
+		}
+		else
+			isValid = 0;
+	}
+	fclose(srcPtr);
+
+	if (!isValid)
+		return lineNum;
+	if (ctrSchedule < FLEET_LIMIT)		// a missing bus is reported on the line after the end of the file
+		return lineNum + 1;
+
+	for (ctrList = 1; ctrList < FLEET_LIMIT; ctrList++)		// findMatchingTime needs the buses of each route in order of departure
+	{
+		memcpy(temp, schedule[ctrList], sizeof(temp));
+		for (ctrSort = ctrList; ctrSort > 0 && (checkRoute(schedule[ctrSort - 1][0], 2) > checkRoute(temp[0], 2) ||
+			(checkRoute(schedule[ctrSort - 1][0], 2) == checkRoute(temp[0], 2) && schedule[ctrSort - 1][1] > temp[1])); ctrSort--)
+			memcpy(schedule[ctrSort], schedule[ctrSort - 1], sizeof(temp));
+		memcpy(schedule[ctrSort], temp, sizeof(temp));
+	}
+
+	return SCHEDULE_OK;
+}
+/* Replaces the active bus schedule used by initializeBus */
+void setSchedule(int schedule[][3])
+{
+	memcpy(busSchedule, schedule, sizeof(busSchedule));
+}
+/* Makes the schedule file the active bus schedule and resets the fleet to it. Keeps the active schedule if the file is missing or invalid.
+   Returns SCHEDULE_OK, SCHEDULE_MISSING, or the line number of the first invalid line. */
+int loadSchedule(struct Bus *fleet, string scheduleName)
+{
+	int schedule[FLEET_LIMIT][3];
+	int errorLine = readScheduleFile(scheduleName, schedule);
+
+	if (errorLine == SCHEDULE_OK)
+	{
+		setSchedule(schedule);
+		initializeBus(fleet);
+	}
+
+	return errorLine;
+}
+/* Switches a running day to the schedule file. The day is replayed into a new fleet on the side and swapped in only if every ticket keeps a trip.
+   Fills movedTickets[] with the tickets whose bus or departure time changed. Returns SCHEDULE_OK, SCHEDULE_MISSING, SCHEDULE_STRANDED, SCHEDULE_TRIP_ERROR, or the line number of the first invalid line. */
+int reloadSchedule(struct Bus *fleet, struct Ticket *p, int *ctrTicket, int currentDate, string scheduleName, int *movedTickets, int *ctrMoved)
+{
+	static struct Bus newFleet[FLEET_LIMIT];		// kept out of the stack because of their size
+	static struct Ticket newPass[DATABASE_LIMIT];
+	struct BusInfo oldInfo, newInfo;
+	int newSchedule[FLEET_LIMIT][3], oldSchedule[FLEET_LIMIT][3];
+	int ctrRoute[2] = {0, 0}, newCount = 0, status, ctrList;
+	string fileName;
+	FILE *srcPtr;
+
+	status = readScheduleFile(scheduleName, newSchedule);
+	if (status != SCHEDULE_OK)
+		return status;
+
+	memcpy(oldSchedule, busSchedule, sizeof(busSchedule));
+	setSchedule(newSchedule);
+	initializeBus(newFleet);
+
+	generateTripFileName(&fileName, currentDate);
+	srcPtr = fopen(fileName, "r");
+	if (srcPtr != NULL)
+	{
+		if (replayTripFile(srcPtr, newFleet, newPass, currentDate, &newCount, ctrRoute) != 0)
+			status = SCHEDULE_TRIP_ERROR;
+		fclose(srcPtr);
+	}
+
+	if (status == SCHEDULE_OK && newCount != *ctrTicket)	// a ticket without a trip would shift the ticket numbers that cancellation records refer to
+		status = SCHEDULE_STRANDED;
+
+	for (ctrList = 0; ctrList < *ctrTicket && status == SCHEDULE_OK; ctrList++)
+		if (newPass[ctrList].busNum == 0 && p[ctrList].busNum != 0)	// a seated passenger pushed off every trip by the new times
+			status = SCHEDULE_STRANDED;
+
+	if (status != SCHEDULE_OK)
+	{
+		setSchedule(oldSchedule);		// the running day is left as it was
+		return status;
+	}
+
+	*ctrMoved = 0;
+	for (ctrList = 0; ctrList < *ctrTicket; ctrList++)
+	{
+		oldInfo.busTime = newInfo.busTime = 0;
+		if (p[ctrList].busNum != 0)
+			queryBus(fleet, p[ctrList].busNum, &oldInfo);
+		if (newPass[ctrList].busNum != 0)
+			queryBus(newFleet, newPass[ctrList].busNum, &newInfo);
+
+		if (p[ctrList].busNum != newPass[ctrList].busNum || oldInfo.busTime != newInfo.busTime)
+		{
+			movedTickets[*ctrMoved] = ctrList;
+			(*ctrMoved)++;
+		}
+	}
+
+	memcpy(fleet, newFleet, sizeof(newFleet));
+	memcpy(p, newPass, sizeof(struct Ticket) * *ctrTicket);
+
+	return SCHEDULE_OK;
+}
+
+/* ADMISSION FUNCTIONS */
+/* Empties the admission queue and sets how long and how deep it may grow before it is released */
+void initializeAdmission(struct AdmissionQueue *queue, int windowLength, int depthLimit)
+{
+	queue->ctrPending = 0;
+	queue->windowStart = 0;
+	queue->windowLength = windowLength;
+	queue->depthLimit = depthLimit > 0 && depthLimit <= ADMISSION_LIMIT ? depthLimit : ADMISSION_LIMIT;
+}
+/* Returns 1 if the queue has waiting requests that must be released before a request made at the given time, otherwise 0 */
+int checkAdmissionDue(const struct AdmissionQueue *queue, int inputTime)
+{
+	int waitTime = (inputTime / 100 * 60 + inputTime % 100) - (queue->windowStart / 100 * 60 + queue->windowStart % 100);	// minutes since the oldest waiting request
+
+	return queue->ctrPending > 0 && (waitTime >= queue->windowLength || waitTime < 0 || queue->ctrPending >= queue->depthLimit);
+}
+/* Adds a request to the admission queue. Returns RESERVE_OK, RESERVE_INVALID, or RESERVE_BUSY if the queue must be released first. */
+int queueTicket(struct AdmissionQueue *queue, const struct Ticket *ticket)
+{
+	if (validateTicket(ticket) != RESERVE_OK)
+		return RESERVE_INVALID;
+	if (checkAdmissionDue(queue, ticket->inputTime))
+		return RESERVE_BUSY;
+
+	if (queue->ctrPending == 0)
+		queue->windowStart = ticket->inputTime;
+	queue->pending[queue->ctrPending] = *ticket;
+	queue->ctrPending++;
+
+	return RESERVE_OK;
+}
+/* Seats every waiting request, highest priority level first and earliest request first within a level, and empties the queue.
+   Fills admitted[] and results[] in the order the requests were seated and returns the number of requests released. */
+int releaseAdmission(struct AdmissionQueue *queue, struct Bus *fleet, struct Ticket *p, int *ctrTicket, string fileName, struct Ticket *admitted, struct Reservation *results)
+{
+	int ctrQueue, ctrSort, ctrReleased = queue->ctrPending;
+	struct Ticket temp;
+
+	for (ctrQueue = 0; ctrQueue < ctrReleased; ctrQueue++)		// insertion sort keeps requests of the same priority and time in arrival order
+	{
+		temp = queue->pending[ctrQueue];
+		for (ctrSort = ctrQueue; ctrSort > 0 && (admitted[ctrSort - 1].priority > temp.priority ||
+			(admitted[ctrSort - 1].priority == temp.priority && admitted[ctrSort - 1].inputTime > temp.inputTime)); ctrSort--)
+			admitted[ctrSort] = admitted[ctrSort - 1];
+		admitted[ctrSort] = temp;
+	}
+
+	queue->ctrPending = 0;
+	reserveBatch(fleet, p, ctrTicket, admitted, ctrReleased, fileName, results);
+
+	return ctrReleased;
+}
+
+/* EXPORT FUNCTIONS */
+/* Generates a manifest file name given a date, a bus number (0 for every bus) and a format */
+void generateManifestFileName(string *fileName, int currentDate, int busNum, int exportFormat)
+{
+	string tripName, tempStr;
+
+	generateTripFileName(&tripName, currentDate);
+	tripName[strlen(tripName) - 4] = '\0';		// removes ".txt"
+
+	strcpy(*fileName, "Manifest");
+	if (busNum > 0)
+	{
+		snprintf(tempStr, sizeof(tempStr), "-AE%d", busNum);
+		strcat(*fileName, tempStr);
+	}
+	strcat(*fileName, tripName + 4);			// skips "Trip"
+
+	if (exportFormat == EXPORT_JSON)
+		strcat(*fileName, ".json");
+	else
+		strcat(*fileName, ".csv");
+}
+/* Writes a string as a CSV field, quoting it if it contains a comma, a quote or a line break */
+static void writeCSVField(FILE *destPtr, const char *inputStr)
+{
+	if (strpbrk(inputStr, ",\"\r\n") == NULL)
+		fputs(inputStr, destPtr);
+	else
+	{
+		fputc('"', destPtr);
+		for (; *inputStr != '\0'; inputStr++)
+		{
+			if (*inputStr == '"')
+				fputc('"', destPtr);		// quotes are escaped by doubling them
+			fputc(*inputStr, destPtr);
+		}
+		fputc('"', destPtr);
+	}
+}
+/* Writes a string as a quoted JSON string */
+static void writeJSONString(FILE *destPtr, const char *inputStr)
+{
+	fputc('"', destPtr);
+	for (; *inputStr != '\0'; inputStr++)
+	{
+		if (*inputStr == '"' || *inputStr == '\\')
+		{
+			fputc('\\', destPtr);
+			fputc(*inputStr, destPtr);
+		}
+		else if ((unsigned char) *inputStr < 0x20)
+			fprintf(destPtr, "\\u%04x", (unsigned char) *inputStr);
+		else
+			fputc(*inputStr, destPtr);
+	}
+	fputc('"', destPtr);
+}
+/* Streams the passenger manifest of one bus (busNum), one route (entryPoint) or the whole day (both 0) to a CSV or JSON file, one bus at a time in order of departure. Returns the number of passengers written, or -1 if the file could not be written. */
+int exportManifest(const struct Bus *fleet, string codes[], int currentDate, int busNum, int entryPoint, int exportFormat, string fileName)
+{
+	static char writeBuffer[EXPORT_BUFFER_SIZE];	// single output buffer for the whole manifest
+	int busOrder[FLEET_LIMIT];						// fleet indices sorted by departure time
+	int ctrOrder = 0, ctrFleet, ctrSort, ctrLoad, ctrPass = 0, ctrBusPass, verifyCode, isFirstBus = 1;
+	const struct Ticket *passenger;
+	FILE *destPtr;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if ((busNum == 0 || fleet[ctrFleet].busNum == busNum) && (entryPoint == 0 || checkRoute(fleet[ctrFleet].busNum, entryPoint)))
+		{
+			ctrSort = ctrOrder++;
+			while (ctrSort > 0 && fleet[busOrder[ctrSort - 1]].busTime > fleet[ctrFleet].busTime)	// insertion sort keeps buses with the same departure in fleet order
+			{
+				busOrder[ctrSort] = busOrder[ctrSort - 1];
+				ctrSort--;
+			}
+			busOrder[ctrSort] = ctrFleet;
+		}
+	}
+
+	destPtr = fopen(fileName, "w");
+	if (destPtr == NULL)
+		return -1;
+	setvbuf(destPtr, writeBuffer, _IOFBF, EXPORT_BUFFER_SIZE);
+
+	if (exportFormat == EXPORT_JSON)
+		fprintf(destPtr, "{\"date\":\"%08d\",\"buses\":[", currentDate);
+	else
+		fprintf(destPtr, "date,bus,departure,limit,seat,ticket,name,id,priority,route,dropoff_code,dropoff\n");
+
+	for (ctrSort = 0; ctrSort < ctrOrder; ctrSort++)
+	{
+		ctrFleet = busOrder[ctrSort];
+		ctrBusPass = 0;
+
+		if (exportFormat == EXPORT_JSON)
+		{
+			fprintf(destPtr, "%s\n{\"bus\":%d,\"departure\":\"%04d\",\"limit\":%d,\"passengers\":[", isFirstBus ? "" : ",", fleet[ctrFleet].busNum, fleet[ctrFleet].busTime, fleet[ctrFleet].limitType);
+			isFirstBus = 0;
+		}
+
+		for (ctrLoad = 0; ctrLoad < fleet[ctrFleet].limitType; ctrLoad++)
+		{
+			if (checkSeat(fleet, ctrFleet, ctrLoad))
+			{
+				passenger = &fleet[ctrFleet].load[ctrLoad];
+				verifyCode = verifyDropOff(passenger->exitPoint, passenger->inputTime, passenger->entryPoint) - 1;
+
+				if (exportFormat == EXPORT_JSON)
+				{
+					fprintf(destPtr, "%s\n{\"seat\":%d,\"ticket\":%d,\"name\":", ctrBusPass > 0 ? "," : "", ctrLoad + 1, passenger->origNum + 1);
+					writeJSONString(destPtr, passenger->passName);
+					fprintf(destPtr, ",\"id\":%d,\"priority\":%d,\"route\":%d,\"dropoff_code\":%d,\"dropoff\":", passenger->idNum, passenger->priority, passenger->entryPoint, passenger->exitPoint);
+					writeJSONString(destPtr, verifyCode >= 0 ? codes[verifyCode] : "");
+					fprintf(destPtr, "}");
+				}
+				else
+				{
+					fprintf(destPtr, "%08d,%d,%04d,%d,%d,%d,", currentDate, fleet[ctrFleet].busNum, fleet[ctrFleet].busTime, fleet[ctrFleet].limitType, ctrLoad + 1, passenger->origNum + 1);
+					writeCSVField(destPtr, passenger->passName);
+					fprintf(destPtr, ",%d,%d,%d,%d,", passenger->idNum, passenger->priority, passenger->entryPoint, passenger->exitPoint);
+					writeCSVField(destPtr, verifyCode >= 0 ? codes[verifyCode] : "");
+					fprintf(destPtr, "\n");
+				}
+
+				ctrBusPass++;
+			}
+		}
+
+		if (exportFormat == EXPORT_JSON)
+			fprintf(destPtr, "]}");
+		ctrPass += ctrBusPass;
+	}
+
+	if (exportFormat == EXPORT_JSON)
+		fprintf(destPtr, "]}\n");
+
+	if (fclose(destPtr) != 0)
+		return -1;
+	return ctrPass;
+}
+
+/* SIMULATION FUNCTIONS */
+/* Sets the load limits of the 13-passenger buses in the fleet according to a capacity policy. Larger vehicles in the schedule keep their layout under every policy. */
+void initializePolicy(struct Bus *fleet, int capacityPolicy)
+{
+	int ctrFleet;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (fleet[ctrFleet].layoutType != LAYOUT13)
+			continue;
+
+		switch (capacityPolicy)
+		{
+			case POLICY_ALL16:
+				setLayout(fleet, ctrFleet, LAYOUT16);
+				fleet[ctrFleet].maxLimit = layoutTable[LAYOUT16].capacity;
+				break;
+			case POLICY_ALL13:
+				fleet[ctrFleet].maxLimit = layoutTable[LAYOUT13].capacity;
+				break;
+			default:
+				break;		// the fleet is left as initializeBus set it from the schedule
+		}
+	}
+}
+/* Replays a day of bookings on a fresh fleet built from the given schedule, or from the active schedule if it is NULL, under a capacity policy. Demand above 100 percent is simulated by booking evenly spaced tickets more than once. Cancelled tickets are left out, and a group is booked together as a single booking. */
+void simulateDay(const struct Ticket *tickets, int ctrTickets, int schedule[][3], int capacityPolicy, int demandPercent, struct Simulation *result)
+{
+	static struct Bus simFleet[FLEET_LIMIT];			// kept out of the stack because of their size
+	static struct Ticket simPass[DATABASE_LIMIT * 4];	// room for up to 400 percent demand
+	struct Ticket group[GROUP_LIMIT];					// live members of the booking being replayed
+	struct Reservation booking, groupResults[GROUP_LIMIT];
+	int seats[GROUP_LIMIT];
+	int ctrSource, ctrCopies, ctrSim = 0, ctrFleet, ctrExtra = 0, ctrMembers, ctrMember, groupSize, isGroup;
+	int oldSchedule[FLEET_LIMIT][3];
+
+	if (schedule != NULL)
+	{
+		memcpy(oldSchedule, busSchedule, sizeof(busSchedule));
+		setSchedule(schedule);
+	}
+	initializeBus(simFleet);
+	if (schedule != NULL)
+		setSchedule(oldSchedule);		// the running day keeps the active schedule
+	initializePolicy(simFleet, capacityPolicy);
+
+	result->ctrRequests = 0;
+	result->ctrServed = 0;
+	result->ctrRejected = 0;
+	result->ctrUnserved = 0;
+	result->ctrDisplaced = 0;
+	result->maxCascade = 0;
+	result->ctrConverted = 0;
+	result->ctrSeats = 0;
+
+	for (ctrSource = 0; ctrSource < ctrTickets; ctrSource += ctrMembers)
+	{
+		isGroup = tickets[ctrSource].groupNum >= 0;
+		ctrMembers = 1;
+		while (isGroup && ctrSource + ctrMembers < ctrTickets && tickets[ctrSource + ctrMembers].groupNum == tickets[ctrSource].groupNum)
+			ctrMembers++;										// the members of a group follow each other, so the whole group is replayed as one booking
+
+		groupSize = 0;
+		for (ctrMember = 0; ctrMember < ctrMembers; ctrMember++)
+		{
+			if (!tickets[ctrSource + ctrMember].isCancelled)	// a cancelled ticket is no longer demand for a seat
+				group[groupSize++] = tickets[ctrSource + ctrMember];
+		}
+		if (groupSize == 0)
+			continue;
+
+		ctrCopies = 1;
+		ctrExtra += demandPercent - 100;		// number of extra copies owed, in percent
+		while (ctrExtra >= 100)
+		{
+			ctrCopies++;
+			ctrExtra -= 100;
+		}
+
+		for (; isGroup && ctrCopies > 0 && ctrSim + groupSize <= DATABASE_LIMIT * 4; ctrCopies--)
+		{
+			seatGroup(simFleet, simPass, ctrSim, DATABASE_LIMIT * 4, group, groupSize, seats, groupResults);
+
+			result->ctrRequests += groupSize;
+			result->ctrConverted += groupResults[0].ctrConverted;
+			if (groupResults[0].status != RESERVE_OK)
+				result->ctrRejected += groupSize;
+			else
+				ctrSim += groupSize;
+		}
+
+		for (; !isGroup && ctrCopies > 0 && ctrSim < DATABASE_LIMIT * 4; ctrCopies--)
+		{
+			simPass[ctrSim] = group[0];
+			simPass[ctrSim].origNum = ctrSim;
+			simPass[ctrSim].busNum = 0;
+			simPass[ctrSim].groupNum = -1;
+			findMatchingTime(simFleet, simPass, ctrSim, &booking);
+
+			result->ctrRequests++;
+			result->ctrDisplaced += booking.ctrDisplaced;
+			result->ctrConverted += booking.ctrConverted;
+			if (booking.ctrDisplaced > result->maxCascade)
+				result->maxCascade = booking.ctrDisplaced;
+			if (booking.status != RESERVE_OK)
+				result->ctrRejected++;
+			if (booking.unservedNum >= 0)
+				result->ctrUnserved++;
+
+			ctrSim++;
+		}
+	}
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		result->ctrServed += checkBusLoad(simFleet, ctrFleet, 1);
+		result->ctrSeats += simFleet[ctrFleet].limitType;
+	}
+}
+
+/* TRACE FUNCTIONS */
+/* Turns the recording of spans on or off */
+void enableTrace(int isEnabled)
+{
+	isTraceEnabled = isEnabled;
+}
+/* Returns the wall-clock start time of a span in microseconds, or 0 if tracing is off */
+long long beginTrace()
+{
+	struct timespec now;
+
+	if (!isTraceEnabled || timespec_get(&now, TIME_UTC) == 0)
+		return 0;
+	return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;		// clock() would count only CPU time and miss time spent waiting on the disk
+}
+/* Records a span that started at startTime in the trace ring, overwriting the oldest span once the ring is full */
+void endTrace(const char *spanName, int ticketNum, int busNum, long long startTime)
+{
+	struct TraceSpan *span;
+
+	if (!isTraceEnabled)
+		return;
+
+	span = &traceRing[ctrTraced % TRACE_LIMIT];
+	span->spanName = spanName;
+	span->ticketNum = ticketNum;
+	span->busNum = busNum;
+	span->startTime = startTime;
+	span->duration = beginTrace() - startTime;
+	ctrTraced++;
+}
+/* Creates the trace file name for the given date */
+void generateTraceFileName(string *fileName, int currentDate)
+{
+	string tripName;
+
+	generateTripFileName(&tripName, currentDate);
+	strcpy(*fileName, "Trace");
+	strcat(*fileName, tripName + 4);					// replaces "Trip" with "Trace" in the file name
+	strcpy(*fileName + strlen(*fileName) - 4, ".json");
+}
+/* Writes the spans in the trace ring, oldest first, as a Chrome trace-event JSON file with ticket numbers counted from 1 as on the console. Returns the number of spans written, or -1 if the file cannot be written. */
+int exportTrace(string fileName)
+{
+	static char writeBuffer[EXPORT_BUFFER_SIZE];
+	long ctrSpan = ctrTraced > TRACE_LIMIT ? ctrTraced - TRACE_LIMIT : 0;
+	int ctrWritten = 0;
+	const struct TraceSpan *span;
+	FILE *destPtr = fopen(fileName, "w");
+
+	if (destPtr == NULL)
+		return -1;
+	setvbuf(destPtr, writeBuffer, _IOFBF, EXPORT_BUFFER_SIZE);
+
+	fprintf(destPtr, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	for (; ctrSpan < ctrTraced; ctrSpan++)
+	{
+		span = &traceRing[ctrSpan % TRACE_LIMIT];
+		fprintf(destPtr, "%s\n{\"name\":\"%s\",\"cat\":\"booking\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%lld,\"args\":{\"ticket\":%d,\"bus\":%d}}",
+				ctrWritten > 0 ? "," : "", span->spanName, span->startTime, span->duration, span->ticketNum >= 0 ? span->ticketNum + 1 : -1, span->busNum);
+		ctrWritten++;
+	}
+	fprintf(destPtr, "\n]}\n");
+
+	if (fclose(destPtr) != 0)
+		return -1;
+	return ctrWritten;
+}
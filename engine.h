@@ -0,0 +1,216 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdio.h>
+
+#define ROUTE_LIMIT 10			// Maximum number of trips per route
+#define SEAT_LIMIT 29			// Maximum capacity of the largest vehicle layout
+#define FLEET_LIMIT 20			// Maximum number of vehicles in the system
+#define DATABASE_LIMIT 580		// Maximum possible number of passengers in the system (29 passengers * 20 buses)
+#define READ_BUFFER_SIZE 65536	// Number of bytes read from a trip file at a time
+#define STANDBY_DIRECTORY "Standby/"	// Directory that receives a copy of every trip file, such as a shared drive of the standby PC
+
+#define LAYOUT13 0				// 13-passenger vehicle
+#define LAYOUT16 1				// 16-passenger vehicle
+#define LAYOUT22 2				// 22-passenger vehicle
+#define LAYOUT29 3				// 29-passenger vehicle
+#define LAYOUT_LIMIT 4			// Number of vehicle layouts
+#define LAYOUT_ROW_LIMIT 8		// Maximum number of rows in a vehicle layout
+#define LAYOUT_COLUMN_LIMIT 5	// Maximum number of seats and aisles across a vehicle layout
+
+#define POLICY_CONVERT 1		// Buses keep the layouts of the schedule, and 13-passenger buses are converted into 16 passengers once full
+#define POLICY_ALL16 2			// 13-passenger buses start with 16 passengers
+#define POLICY_ALL13 3			// 13-passenger buses are never converted
+#define POLICY_LIMIT 3			// Number of capacity policies
+
+#define EXPORT_CSV 1			// Manifest written as comma-separated values
+#define EXPORT_JSON 2			// Manifest written as a JSON document
+#define EXPORT_BUFFER_SIZE 65536	// Number of bytes buffered before a manifest is written to disk
+#define TRACE_LIMIT 8192		// Number of most recent spans kept while tracing
+
+#define RESERVE_OK 0			// Passenger has been given a seat
+#define RESERVE_NO_TRIP -1		// No trip of the route leaves after the passenger's input time
+#define RESERVE_NO_SEAT -2		// Every later trip is full of passengers with the same or higher priority
+#define RESERVE_INVALID -3		// Ticket details did not pass validation
+#define RESERVE_NOT_FOUND -4	// Ticket to be cancelled is not seated on any bus
+#define RESERVE_BUSY -5			// Admission queue is full and must be released before it takes more requests
+
+#define SCHEDULE_FILE "Schedule.txt"	// Bus schedule read at startup and whenever it is reloaded
+#define SCHEDULE_OK 0			// Schedule file has been read
+#define SCHEDULE_MISSING -1		// Schedule file does not exist
+#define SCHEDULE_STRANDED -2	// A reserved ticket has no trip in the new schedule
+#define SCHEDULE_TRIP_ERROR -3	// Trip file could not be replayed on the new schedule
+
+#define GROUP_LIMIT 16			// Maximum number of passengers in a group booking
+
+#define ADMISSION_LIMIT 64		// Maximum number of requests held in the admission queue
+#define ADMISSION_WINDOW 10		// Default number of minutes of request time held in the admission queue
+#define ADMISSION_DEPTH 32		// Default number of held requests at which new requests are turned away
+
+typedef char string[100];
+
+/* DATA STRUCTURES */
+typedef struct Ticket
+{
+	int origNum;				// Ticket identification.		Example: 2 (Ticket #2)
+	int inputDate;				// Date of entry.				Example: 03212020 (March 21, 2020)
+	int inputTime;				// Time of entry.				Example: 1500H
+	string passName;			// Name of passenger.			Example: Jean-Baptiste de La Salle
+	int idNum;					// 7 to 8 digit ID number.		Example: 12345678
+	int priority;				// Priority level from 1-6.		Example: 6 (Employees and Students with official business)
+	int entryPoint;				// Point of entry. 				Example: 1 (Manila)
+	int exitPoint;				// Point of exit. 				Example: 110 (Mamplasan Exit)
+	int busNum;					// Bus assigned to passenger.	Example: AE101
+	int groupNum;				// First ticket of the passenger's group, or -1 if booked alone.	Example: 4 (Ticket #4)
+	int isCancelled;			// 1 if the ticket was cancelled, otherwise 0
+} Ticket;
+
+typedef struct Layout
+{
+	int capacity;				// Number of passenger seats.	Example: 13
+	int ctrColumns;				// Number of seats and aisles across the vehicle
+	int ctrRows;				// Number of rows including the driver row
+	char rowPlan[LAYOUT_ROW_LIMIT][LAYOUT_COLUMN_LIMIT + 1];	// Rows from the back of the vehicle. 'S' is a seat, 'A' is an aisle and 'D' is the driver, who takes the rest of the row and at least two columns
+	int convertsTo;				// Layout that a full vehicle can be converted into, or -1 if none
+} Layout;
+
+typedef struct Bus
+{
+	Ticket load[SEAT_LIMIT];	// Total capacity set at a maximum of the largest layout
+	int layoutType;				// Seat layout of the vehicle.	Example: LAYOUT13
+	int limitType;				// Determines the load limit, which is the capacity of the seat layout
+	int busNum;					// Unique bus number.			Example: AE101
+	int busTime;				// Bus departure time.			Example: 1530H
+	unsigned long seatMask;		// Bit n is set if seat n is occupied.	Example: 0x7 (Seats 1 to 3)
+	int maxLimit;				// Largest load limit the bus can be converted to
+} Bus;
+
+typedef struct Reservation
+{
+	int status;					// Result of the request.		Example: RESERVE_OK
+	int ticketNum;				// Ticket that was requested.	Example: 2 (Ticket #2)
+	int busIndex;				// Index of the assigned bus in the fleet, or -1 if none
+	int busNum;					// Bus assigned to passenger.	Example: AE101
+	int busTime;				// Departure time of the bus.	Example: 1530H
+	int seatNum;				// Index of the assigned seat, or -1 if none
+	int ctrConverted;			// Number of buses converted into a larger layout
+	int ctrDisplaced;			// Number of passengers moved to a later trip to make room
+	int unservedNum;			// Ticket of a moved passenger left without a trip, or -1 if none
+} Reservation;
+
+typedef struct BusInfo
+{
+	int busNum;					// Unique bus number.			Example: AE101
+	int busTime;				// Bus departure time.			Example: 1530H
+	int limitType;				// Current load limit, which is the capacity of the seat layout
+	int ctrUsed;				// Number of occupied seats
+	int dropOffs[ROUTE_LIMIT];	// Number of passengers for each drop-off point, in the order of the codes[] array
+} BusInfo;
+
+typedef struct Availability
+{
+	int ctrTrips;				// Number of departures in the time range
+	int ctrFree;				// Number of vacant seats, counting the seats added when a full bus is converted
+	int ctrPriority[6];			// Number of occupied seats held by passengers who can be moved to a later trip, for each priority level from level 1 to level 6
+	int ctrGrouped;				// Number of occupied seats held by members of a group, who are never moved
+} Availability;
+
+typedef struct Simulation
+{
+	int ctrRequests;			// Number of bookings replayed
+	int ctrServed;				// Number of passengers seated at the end of the day
+	int ctrRejected;			// Number of bookings that found no trip or no seat
+	int ctrUnserved;			// Number of passengers moved out of a bus with no later trip left
+	int ctrDisplaced;			// Number of times a passenger was moved to a later trip
+	int maxCascade;				// Most passengers moved by a single booking
+	int ctrConverted;			// Number of buses converted into a larger layout
+	int ctrSeats;				// Number of seats offered at the end of the day
+} Simulation;
+
+typedef struct AdmissionQueue
+{
+	Ticket pending[ADMISSION_LIMIT];	// Requests waiting to be seated, in the order they arrived
+	int ctrPending;				// Number of requests waiting
+	int windowStart;			// Request time of the oldest waiting request.	Example: 0700H
+	int windowLength;			// Minutes of request time held before the queue is released
+	int depthLimit;				// Number of waiting requests at which new requests are turned away
+} AdmissionQueue;
+
+/* SPECIFIC INPUT VERIFICATION FUNCTIONS */
+int checkIfLeap(int inputYear);
+int getDaysInMonth(int inputDate);
+int getNextDate(int inputDate);
+int getSortableDate(int inputDate);
+int checkIfDay(int inputDate, int numDaysInMonth);
+int checkIfMonth(int inputDate);
+int checkIf24H(int inputTime);
+int verifyIDNumber(int inputNum);
+int verifyDropOff(int inputKey, int inputTime, int entryPoint);
+int checkRoute(int busNum, int entryPoint);
+int validateTicket(const struct Ticket *ticket);
+
+/* SEAT STATE FUNCTIONS */
+const struct Layout *getLayout(int layoutType);
+void setLayout(struct Bus *fleet, int ctrBus, int layoutType);
+int checkConvertible(const struct Bus *fleet, int ctrBus);
+int getFullCapacity(const struct Bus *fleet, int ctrBus);
+int checkSeat(const struct Bus *fleet, int ctrBus, int ctrSeat);
+int countSeats(unsigned long seatMask);
+int findVacantSeat(unsigned long seatMask, int localLimit);
+int checkBusLoad(const struct Bus *fleet, int ctrBus, int returnMode);
+void countBusDropOffs(const struct Bus *fleet, int ctrBus, int *dropOffs);
+
+/* ALLOCATION FUNCTIONS */
+void initializeBus(struct Bus *fleet);
+int findMatchingTime(struct Bus *fleet, struct Ticket *p, int ctrTicket, struct Reservation *result);
+
+/* FILE FUNCTIONS */
+void generateTripFileName(string *fileName, int currentDate);
+int replayTripFile(FILE *srcPtr, struct Bus *fleet, struct Ticket *p, int currentDate, int *ctrTicket, int *ctrRoute);
+int loadTripFile(struct Bus *fleet, struct Ticket *p, int currentDate, int *ctrTicket, int *ctrRoute);
+void publishFleetStatus(const struct Bus *fleet, int currentDate);
+long shipTripFile(int currentDate);
+int restoreTripFile(int currentDate);
+long getFileSize(string fileName);
+void generateSnapshotFileName(string *fileName, int currentDate);
+int saveSnapshot(const struct Bus *fleet, int currentDate);
+int loadSnapshot(struct Bus *fleet, int currentDate);
+
+/* ENGINE INTERFACE */
+int reserveTicket(struct Bus *fleet, struct Ticket *p, int ctrTicket, string fileName, struct Reservation *result);
+int reserveBatch(struct Bus *fleet, struct Ticket *p, int *ctrTicket, const struct Ticket *batch, int batchSize, string fileName, struct Reservation *results);
+int reserveGroup(struct Bus *fleet, struct Ticket *p, int *ctrTicket, const struct Ticket *group, int groupSize, string fileName, struct Reservation *results);
+int cancelTicket(struct Bus *fleet, struct Ticket *p, int ctrTicket, string fileName);
+int queryBus(const struct Bus *fleet, int busNum, struct BusInfo *result);
+void queryDropOffs(const struct Bus *fleet, int *dropOffs);
+void queryAvailability(const struct Bus *fleet, int entryPoint, int startTime, int endTime, struct Availability *result);
+int findEarliestSeat(const struct Bus *fleet, int entryPoint, int inputTime, int priority);
+
+/* SCHEDULE FUNCTIONS */
+int readScheduleFile(string fileName, int schedule[][3]);
+void setSchedule(int schedule[][3]);
+int loadSchedule(struct Bus *fleet, string scheduleName);
+int reloadSchedule(struct Bus *fleet, struct Ticket *p, int *ctrTicket, int currentDate, string scheduleName, int *movedTickets, int *ctrMoved);
+
+/* ADMISSION FUNCTIONS */
+void initializeAdmission(struct AdmissionQueue *queue, int windowLength, int depthLimit);
+int checkAdmissionDue(const struct AdmissionQueue *queue, int inputTime);
+int queueTicket(struct AdmissionQueue *queue, const struct Ticket *ticket);
+int releaseAdmission(struct AdmissionQueue *queue, struct Bus *fleet, struct Ticket *p, int *ctrTicket, string fileName, struct Ticket *admitted, struct Reservation *results);
+
+/* EXPORT FUNCTIONS */
+void generateManifestFileName(string *fileName, int currentDate, int busNum, int exportFormat);
+int exportManifest(const struct Bus *fleet, string codes[], int currentDate, int busNum, int entryPoint, int exportFormat, string fileName);
+
+/* SIMULATION FUNCTIONS */
+void initializePolicy(struct Bus *fleet, int capacityPolicy);
+void simulateDay(const struct Ticket *tickets, int ctrTickets, int schedule[][3], int capacityPolicy, int demandPercent, struct Simulation *result);
+
+/* TRACE FUNCTIONS */
+void enableTrace(int isEnabled);
+long long beginTrace();
+void endTrace(const char *spanName, int ticketNum, int busNum, long long startTime);
+void generateTraceFileName(string *fileName, int currentDate);
+int exportTrace(string fileName);
+
+#endif
@@ -1,192 +1,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-#define ROUTE_LIMIT 10			// Maximum number of trips per route
-#define BUS13_LIMIT 13			// Maximum capacity of a 13-passenger vehicle
-#define BUS16_LIMIT 16			// Maximum capacity of a 16-passenger vehicle
-#define FLEET_LIMIT 20			// Maximum number of vehicles in the system
-#define DATABASE_LIMIT 320		// Maximum possible number of passengers in the system (16 passengers * 20 buses)
-#define MENU_EXIT_OPTION 4		// User key to quit the program in the main menu
+#include "engine.h"
 
-typedef char string[100];
+#define MENU_EXIT_OPTION 11		// User key to quit the program in the main menu
+#define SEATMAP_SIZE 1024		// Maximum number of characters in the seat map of a vehicle layout
 
-/* DATA STRUCTURES */
-typedef struct Ticket
+typedef struct SeatMap
 {
-	int origNum;				// Ticket identification.		Example: 2 (Ticket #2)
-	int inputDate;				// Date of entry.				Example: 03212020 (March 21, 2020)
-	int inputTime;				// Time of entry.				Example: 1500H
-	string passName;			// Name of passenger.			Example: Jean-Baptiste de La Salle
-	int idNum;					// 7 to 8 digit ID number.		Example: 12345678
-	int priority;				// Priority level from 1-6.		Example: 6 (Employees and Students with official business)
-	int entryPoint;				// Point of entry. 				Example: 1 (Manila)
-	int exitPoint;				// Point of exit. 				Example: 110 (Mamplasan Exit)
-	int busNum;					// Bus assigned to passenger.	Example: AE101
-} Ticket;
-
-typedef struct Bus
-{
-	Ticket load[BUS16_LIMIT];	// Total capacity set at a maximum of 16 passengers
-	int limitType;				// Determines the load limit, either 13 passengers or 16 passengers
-	int busNum;					// Unique bus number.			Example: AE101
-	int busTime;				// Bus departure time.			Example: 1530H
-} Bus;
-
-/* SPECIFIC INPUT VERIFICATION FUNCTIONS */
-/* Determines if the year is a leap year */
-int checkIfLeap(int inputYear)
-{
-	if ((inputYear % 4 == 0 && inputYear % 100 != 0) || inputYear % 400 == 0)
-		return 1;
-	else
-		return 0;
-}
-/* Determines number of days in a month */
-int getDaysInMonth(int inputDate)
-{
-	int inputMonth = inputDate / 1000000;
-	int inputYear = inputDate % 10000;
-	switch (inputMonth)
-	{
-		case 1:
-		case 3:
-		case 5:
-		case 7:
-		case 8:
-		case 10:
-		case 12:
-			return 31;
-			break;
-		case 4:
-		case 6:
-		case 9:
-		case 11:
-			return 30;
-			break;
-		case 2:
-			if (checkIfLeap(inputYear))
-				return 29;
-			else
-				return 28;
-		default:
-			return 0;
-			break;
-	}
-}
-/* Validate if the given inputDate has a valid day of a month */
-int checkIfDay(int inputDate, int numDaysInMonth)
-{
-	if (inputDate > 0)
-	{
-		inputDate /= 10000;
-		inputDate %= 100;
-		if (inputDate <= numDaysInMonth)
-			return 1;
-	}
-
-	return 0;
-}
-/* Validate if the given inputDate has a valid month of a year */
-int checkIfMonth(int inputDate)
-{
-	inputDate /= 1000000;
-	if (inputDate >= 1 && inputDate <= 12)
-		return 1;
-	else
-		return 0;
-}
-/* Validate if the given inputTime is in 24H time format */
-int checkIf24H(int inputTime)
-{
-	if (!(inputTime / 100 < 24 && inputTime % 100 < 60) || inputTime < 0)
-		return 0;
-	else
-		return 1;
-}
-/* Verifies if the given ID number is at least 7 to 8 digits long */
-int verifyIDNumber(int inputNum)
-{
-	int ctrID = 0;
-	while (inputNum > 0)
-	{
-		inputNum /= 10;
-		ctrID++;
-	}
-
-	if (ctrID >= 7 && ctrID <= 8) // checks that ID numbers are 7-8 digits only
-		return 1;
-	else
-		return 0;
-}
-/* Verifies if the given drop-off code is valid. If valid, it returns the index + 1 of the drop-off code. */
-int verifyDropOff(int inputKey, int inputTime, int entryPoint)
-{
-	int specialCase;
-	if (inputTime > 1529 && inputTime < 1815)	// only allows drop-off code 104 for AE108 and AE109
-		specialCase = 1;
-	else
-		specialCase = 0;
-
-	switch (entryPoint)
-	{
-		case 1:						// Manila -> Laguna routes only
-			switch (inputKey)
-			{
-				case 101:	
-					return 1;
-					break;
-				case 102:
-					return 2;
-					break;
-				case 103:
-				case 112:
-					return 3;
-					break;
-				case 111:
-					return 5;
-					break;
-				case 104:
-					if (specialCase)
-						return 4;
-					else
-						return 0;
-					break;
-				default:
-					return 0; // returns only if invalid
-					break;
-			}
-		case 2:					// Laguna -> Manila routes only
-			switch (inputKey)
-			{
-				case 201:
-					return 6;
-					break;
-				case 221:
-					return 7;
-					break;
-				case 211:
-				case 222:
-					return 8;
-					break;
-				case 212:
-				case 223:
-					return 9;
-					break;
-				case 213:
-				case 224:
-					return 10;
-					break;
-
-				default:
-					return 0; // returns only if invalid
-					break;
-			}
-		default:
-			return 0;
-			break;
-	}
-}
+	char text[SEATMAP_SIZE];		// Seat map of a layout with every seat vacant
+	int seatOffset[SEAT_LIMIT];		// Position of each seat in the text
+	int busOffset;					// Position of the bus number in the text
+	int timeOffset;					// Position of the departure time in the text
+	int isBuilt;					// 1 once the seat map has been written
+} SeatMap;
 
 /* SYSTEM DISPLAY FUNCTIONS */
 /* Accepts a number in HHMM format and prints it in 24-hour time format. */
@@ -215,87 +44,81 @@ void printDate(int inputDate)
 		printf("0");
 	printf("%d/%d", day, year);
 }
-/* Displays the 13-seater bus configuration */
-void displayConfig13(struct Bus *fleet, int ctrBus)
+/* Writes the seat map of a vehicle layout with every seat vacant and records where each seat, the bus number and the departure time are drawn */
+void buildSeatMap(struct SeatMap *map, const struct Layout *layout)
 {
-	int x, y, ctrSeat = 0;
+	int ctrRow, ctrColumn, ctrSeat = 0, length = 0, width, driverColumn;
+	char border[LAYOUT_COLUMN_LIMIT * 4 + 3];
 
-	printf("\n*---*---*---*\n");
-	for (x = 0; x < 4; x++)
+	for (ctrColumn = 0; ctrColumn < layout->ctrColumns; ctrColumn++)
+		strcpy(border + ctrColumn * 4, "*---");
+	strcpy(border + layout->ctrColumns * 4, "*\n");
+
+	length += sprintf(map->text + length, "\n%s", border);
+	for (ctrRow = 0; ctrRow < layout->ctrRows; ctrRow++)
 	{
-		printf("| ");
-		for (y = 0; y < 3; y++)
+		driverColumn = -1;
+		for (ctrColumn = 0; ctrColumn < layout->ctrColumns && driverColumn < 0 && layout->rowPlan[ctrRow][ctrColumn] != '\0'; ctrColumn++)
 		{
-			if (fleet[ctrBus].load[ctrSeat].exitPoint != 0)
-				printf("O");
-			else
-				printf("X");
-			ctrSeat++;
-			if (y < 2)
-				printf(" | ");
+			switch (layout->rowPlan[ctrRow][ctrColumn])
+			{
+				case 'S':
+					map->seatOffset[ctrSeat++] = length + 2;
+					length += sprintf(map->text + length, "| X ");
+					break;
+				case 'D':				// the driver cell takes the rest of the row and shows the bus number
+					driverColumn = ctrColumn;
+					width = (layout->ctrColumns - ctrColumn) * 4 - 1;
+					map->busOffset = length + 1 + (width - 5) / 2;
+					length += sprintf(map->text + length, "|%*s", width, "");
+					break;
+				default:				// aisle
+					length += sprintf(map->text + length, "|   ");
+					break;
+			}
 		}
-		printf(" |");
-		printf("\n*---*---*---*\n");
-	}
-
-	if (fleet[ctrBus].load[ctrSeat].exitPoint != 0)
-		printf("| O | ");
-	else
-		printf("| X | ");
+		length += sprintf(map->text + length, "|\n");
 
-	printf("AE%d |\n", fleet[ctrBus].busNum);
-	printf("|   | ");
-	printIn24H(fleet[ctrBus].busTime);
-	printf(" |");
-	printf("\n*---*---*---*\n");
-}
-/* Displays the 16-seater bus configuration */
-void displayConfig16(struct Bus *fleet, int ctrBus)
-{
-	int x, y, ctrSeat = 0;
-	// displays the first three rows of the bus
-	printf("\n*---*---*---*---*\n");
-	for (x = 0; x < 3; x++)
-	{
-		printf("| ");
-		for (y = 0; y < 4; y++)
+		if (driverColumn >= 0)			// a second line under the driver cell shows the departure time
 		{
-			if (fleet[ctrBus].load[ctrSeat].exitPoint != 0)
-				printf("O");
-			else
-				printf("X");
-			ctrSeat++;
-			if (y < 3)
-				printf(" | ");
+			for (ctrColumn = 0; ctrColumn < driverColumn; ctrColumn++)
+				length += sprintf(map->text + length, "|   ");
+			map->timeOffset = length + 1 + (width - 5) / 2;
+			length += sprintf(map->text + length, "|%*s|\n", width, "");
 		}
-		printf(" |");
-		printf("\n*---*---*---*---*\n");
+		length += sprintf(map->text + length, "%s", border);
 	}
-	// displays the fourth row of the bus
-	printf("|   ");
-	for (x = 0; x < 3; x++)
+
+	map->isBuilt = 1;
+}
+/* Displays the seat configuration of a bus using the seat map of its layout */
+void displayConfig(const struct Bus *fleet, int ctrBus)
+{
+	static struct SeatMap seatMaps[LAYOUT_LIMIT];	// seat maps are built the first time each layout is displayed
+	struct SeatMap *map = &seatMaps[fleet[ctrBus].layoutType];
+	char text[SEATMAP_SIZE];
+	char field[12];
+	int ctrSeat;
+
+	if (!map->isBuilt)
+		buildSeatMap(map, getLayout(fleet[ctrBus].layoutType));
+
+	memcpy(text, map->text, SEATMAP_SIZE);
+	for (ctrSeat = 0; ctrSeat < fleet[ctrBus].limitType; ctrSeat++)
 	{
-		if (fleet[ctrBus].load[ctrSeat].exitPoint != 0)
-			printf("| O ");
-		else
-			printf("| X ");
+		if (checkSeat(fleet, ctrBus, ctrSeat))
+			text[map->seatOffset[ctrSeat]] = 'O';
 	}
-	// displays the fifth row of the bus
-	printf("|\n");
-	printf("|   *---*---*---*\n");
-	if (fleet[ctrBus].load[ctrSeat].exitPoint != 0)
-		printf("| O ");
-	else
-		printf("| X ");
 
-	printf("|   AE%d   |\n", fleet[ctrBus].busNum);
-	printf("|   |   ");
-	printIn24H(fleet[ctrBus].busTime);
-	printf("   |");
-	printf("\n*---*---*---*---*\n");
+	sprintf(field, "AE%d", fleet[ctrBus].busNum);
+	memcpy(text + map->busOffset, field, strlen(field));
+	sprintf(field, "%04dH", fleet[ctrBus].busTime);
+	memcpy(text + map->timeOffset, field, strlen(field));
+
+	printf("%s", text);
 }
 /* Display passenger info of a specific passenger of a specific bus unit */
-void displayPassInfo(string codes[], int searchKey, struct Bus *fleet, int ctrBus, int currentDate)
+void displayPassInfo(string codes[], int searchKey, const struct Bus *fleet, int ctrBus, int currentDate)
 {
 	int localLimit = fleet[ctrBus].limitType, ctrLoad;
 	for (ctrLoad = 0; ctrLoad < localLimit; ctrLoad++)
@@ -307,7 +130,7 @@ void displayPassInfo(string codes[], int searchKey, struct Bus *fleet, int ctrBu
 			printDate(currentDate);
 			printf("\n\nBus AE%d - Seat %d - Ticket #%d\n", fleet[ctrBus].busNum, ctrLoad + 2, fleet[ctrBus].load[ctrLoad].origNum);
 
-			if (fleet[ctrBus].load[ctrLoad].busNum != 0 && fleet[ctrBus].load[ctrLoad].exitPoint != 0)
+			if (checkSeat(fleet, ctrBus, ctrLoad))
 			{
 				printDate(currentDate);
 				printf(" ");
@@ -382,210 +205,6 @@ void countDropOff()
 }
 
 /* MAIN FUNCTIONS */
-/* Returns the current load of a bus. See documentation below for different return modes. */
-int checkBusLoad(struct Bus *fleet, int ctrBus, int returnMode)
-{
-	int ctrUsed = 0, ctrLoad = 0;
-	int localLimit = fleet[ctrBus].limitType;
-	int ctrVacant = 0;				// lowest index that contains a vacant seat
-
-	while (ctrLoad < localLimit)
-	{
-		if (fleet[ctrBus].load[ctrLoad].busNum != 0 && fleet[ctrBus].load[ctrLoad].exitPoint != 0) // both values are 0 if the specific seat is unoccupied
-			ctrUsed++;				// number of occupied seats on a bus
-		else
-			ctrVacant = ctrUsed;
-
-		ctrLoad++;					// number of seats on a bus
-	}
-	//printf("AE%d: (%d/%d)\n", fleet[ctrBus].busNum, ctrUsed, fleet[ctrBus].limitType);
-	switch (returnMode)
-	{
-		case 1:						// MODE 1: returns only the number of passenger onboard
-			return ctrUsed;			
-			break;
-		case 2:						// MODE 2: returns only whether a bus is full or not in this mode
-			switch (ctrUsed)
-			{
-				case BUS13_LIMIT:
-					if (fleet[ctrBus].limitType == BUS13_LIMIT)
-						return -1; 	// returns -1 if a 13-passenger bus is full
-					else
-						return 0;	// returns 0 if a 16-passenger bus has 13 passengers, which is not full yet
-					break;
-				case BUS16_LIMIT:
-					return -2; 		// returns -2 if a 16-passenger bus is full
-					break;
-				default:
-					return 0;		// returns 0 if either kind of bus has vacant seats
-					break;
-			}
-			break;
-		case 3:						// MODE 3: returns the index of a vacant seat on the bus
-			return ctrVacant;
-			break;
-	}
-
-	return -1;
-}
-/* Gets the lowest leveled passenger onboard and returns the ticket index of the passenger to be reprocessed into the system*/
-int priorityManager(struct Bus *fleet, struct Ticket *p, int ctrTicket, int *ctrFindBus)
-{
-	struct Bus currBus = fleet[*ctrFindBus];			// bus struct container for the current bus
-	struct Ticket temp;									// passenger struct container for outgoing passenger
-	int localLimit = fleet[*ctrFindBus].limitType;		// current bus capacity
-	int lowestIndex = 0;		// stores the index of the lowest priority leveled passenger
-	int ctrLoad;				// counter for getting the lowest priority leveled passenger
-
-	for (ctrLoad = 0; ctrLoad < localLimit; ctrLoad++)		// get lowest priority leveled passenger
-	{
-		if (currBus.load[ctrLoad].priority > currBus.load[lowestIndex].priority)
-			lowestIndex = ctrLoad;
-	}
-
-	if (currBus.load[lowestIndex].priority > p[ctrTicket].priority) // compares the incoming passenger with the lowest priority passenger
-	{
-		temp = fleet[*ctrFindBus].load[lowestIndex];
-		printf("\n[SYSTEM] Passenger #%d with priority level %d has been accomodated into Bus AE%d.\n", p[ctrTicket].origNum, p[ctrTicket].priority, fleet[*ctrFindBus].busNum);
-		
-		fleet[*ctrFindBus].load[lowestIndex] = p[ctrTicket];
-		printf("\n[SYSTEM] Passenger #%d with priority level %d has been moved out of Bus AE%d.\n", temp.origNum, temp.priority, temp.busNum);
-		return temp.origNum;	// returns the index of the outgoing passenger
-	}
-	else
-		return -1;
-}
-/* Looks for an available bus schedule given the input time */
-int findMatchingTime(struct Bus *fleet, struct Ticket *p, int ctrTicket)
-{
-	int searchTime, timeFound = 0, ctrValidIndex = 0, ctrFindBus = 0, ctrOut;
-	struct Bus nextSched, lastSched;
-
-	lastSched = fleet[FLEET_LIMIT - 1];
-
-	while (timeFound == 0)
-	{
-		searchTime = p[ctrTicket].inputTime;	// updates every loop to get schedules later than the time
-		switch (p[ctrTicket].entryPoint) // restricts the fleet options to only specific routes if needed
-		{
-			case 1:						// restricts to only Manila -> Laguna
-				if (ctrFindBus == 0 && ctrValidIndex == 0)
-					ctrFindBus = 0;
-
-				if (fleet[ctrFindBus].busNum > 100 && fleet[ctrFindBus].busNum < 110)
-					ctrValidIndex = 1;
-				break;
-			case 2:						// restricts to only Laguna -> Manila
-				if (ctrFindBus == 0 && ctrValidIndex == 0)
-					ctrFindBus = 9;
-
-				if (fleet[ctrFindBus].busNum > 149 && fleet[ctrFindBus].busNum < 161)
-					ctrValidIndex = 1;
-				break;
-		}
-
-		nextSched = fleet[ctrFindBus];
-
-		//printf("\n#%d: %d < AE%d (%d/%d): %d && %d: %d\n", ctrTicket, searchTime, nextSched.busNum, checkBusLoad(fleet, ctrFindBus, 1), nextSched.limitType, nextSched.busTime, p[ctrTicket].entryPoint, ctrValidIndex);
-
-		if (searchTime < nextSched.busTime && ctrValidIndex) 	// checks for a bus schedule compatible with the passenger's input time
-		{
-			if (checkBusLoad(fleet, ctrFindBus, 2) == -1 && fleet[ctrFindBus].limitType == BUS13_LIMIT)
-			{
-				fleet[ctrFindBus].limitType = BUS16_LIMIT;
-				printf("\n[SYSTEM] AE%d has been converted into a 16-passenger configuration.\n", fleet[ctrFindBus].busNum);
-			}
-
-			switch (checkBusLoad(fleet, ctrFindBus, 2))
-			{
-				case 0:
-					system("cls");
-					printf("\n[SYSTEM] Passenger #%d is elligible to board AE%d at ", ctrTicket + 1, nextSched.busNum);
-					printIn24H(nextSched.busTime);
-					printf(".\n");
-					timeFound = 1;
-					return ctrFindBus; // returns the bus index in the bus array if a time is found
-					break;
-				case -2:
-					ctrOut = priorityManager(fleet, p, ctrTicket, &ctrFindBus); // sets the removed passenger back into the loop
-					if (ctrOut >= 0)														   // checks if the index is valid, otherwise it means there is no more to remove from the bus
-					{
-						ctrTicket = ctrOut;
-						ctrFindBus++;
-					}
-					break;
-			}
-		}
-
-		else if (searchTime >= lastSched.busTime)
-		{
-			system("cls");
-			printf("\n[SYSTEM] No more elligible trips for the day!\n");
-			timeFound = 1;
-			return -1; // returns negative if there are no more available trips
-		}
-		else
-			ctrFindBus++;
-	}
-
-	return 0; // returns 0 if it has not yet found a matching schedule
-}
-/* Saves passenger structs to a text file */
-void saveToTripFile(struct Bus *fleet, struct Ticket *p, int ctrBus, int ctrTicket, int ctrSeat, string fileName)
-{
-	FILE *destPtr;
-	string matchStr = "Trip";
-	int ctrValid = 0;
-	int ctrCheck;								 // counter to check first four letters of filename
-
-	for (ctrCheck = 0; ctrCheck < 4; ctrCheck++) // checks if the filename has "Trip" in it
-	{
-		if (fileName[ctrCheck] == matchStr[ctrCheck])
-			ctrValid = 1;
-		else
-			ctrValid = 0;
-	}
-
-	if (ctrValid)
-	{
-		destPtr = fopen(fileName, "a+");
-		fprintf(destPtr, "\n");
-
-		switch (p[ctrTicket].entryPoint) // write embarkation point to file
-		{
-			case 1:
-				fprintf(destPtr, "Manila\n");
-				break;
-			case 2:
-				fprintf(destPtr, "Laguna\n");
-				break;
-			default:
-				printf("[ERROR] A writing error was detected while writing to file \"%s\".\n", fileName);
-				ctrValid = 0;
-				break;
-		}
-
-		if (ctrValid)
-		{
-			fprintf(destPtr, "%s\n", p[ctrTicket].passName);
-			fprintf(destPtr, "%d\n%d\n%d\n%d\n%d\n%d\n%d\n", p[ctrTicket].idNum, p[ctrTicket].priority, p[ctrTicket].inputTime, fleet[ctrBus].busNum, fleet[ctrBus].limitType, ctrSeat, p[ctrTicket].exitPoint); // write passenger name to file
-		}
-
-		fclose(destPtr);
-	}
-}
-/* Assigns passenger struct to the bus struct's load */
-void assignToSeat(struct Bus *fleet, struct Ticket *p, int ctrBus, int ctrTicket, string fileName)
-{
-	int ctrSeat = checkBusLoad(fleet, ctrBus, 3);				// gets an index for a vacant seat onboard the bus
-	if (ctrSeat > -1)
-	{
-		p[ctrTicket].busNum = fleet[ctrBus].busNum;		 // assigns passenger's bus number with bus number
-		fleet[ctrBus].load[ctrSeat] = p[ctrTicket];		 // assigns passenger to the bus load at that index
-		fleet[ctrBus].load[ctrSeat].origNum = ctrTicket; // saves the passenger number to their info card
-		saveToTripFile(fleet, p, ctrBus, ctrTicket, ctrSeat, fileName);
-	}
-}
 /* Prints out all drop-off points in full names */
 void displayAllRoutes(string codes[], int entryPoint, int inputTime)
 {
@@ -626,7 +245,7 @@ void displayAllRoutes(string codes[], int entryPoint, int inputTime)
 }
 
 /* Displays all buses in the bus fleet. */
-void displayAllBuses(struct Bus *fleet)
+void displayAllBuses(const struct Bus *fleet)
 {
 	int ctrFleet;
 
@@ -679,7 +298,7 @@ void verifyIntInput(int inputItem, int *inputDir, int inputItem2, int inputItem3
 					strcpy(errorMsg, "Please enter a valid ID number.");
 				break;
 			case 5: // verify priority level
-				if (inputTemp >= 0 && inputTemp <= 6)
+				if (inputTemp >= 1 && inputTemp <= 6)
 					inputValid = 1;
 				else
 					strcpy(errorMsg, "Please enter a valid priority level from 1 to 6.");
@@ -698,7 +317,7 @@ void verifyIntInput(int inputItem, int *inputDir, int inputItem2, int inputItem3
 				break;
 			
 			case 10: // verify menu option choice
-				if (inputTemp >= 1 && inputTemp <= 5)
+				if (inputTemp >= 1 && inputTemp <= MENU_EXIT_OPTION)
 					inputValid = 1;
 				else
 					strcpy(errorMsg, "Please enter a valid input.");
@@ -710,6 +329,13 @@ void verifyIntInput(int inputItem, int *inputDir, int inputItem2, int inputItem3
 					strcpy(errorMsg, "Please enter a valid bus number.");
 				break;
 
+			case 13: // verify option choice from 1 to inputItem2
+				if (inputTemp >= 1 && inputTemp <= inputItem2)
+					inputValid = 1;
+				else
+					strcpy(errorMsg, "Please enter a valid option.");
+				break;
+
 			case 12: // verify bus seat selection
 				if (inputTemp - 1 >= -1 && inputTemp - 1 < inputItem2)
 					inputValid = 1;
@@ -754,33 +380,11 @@ void inputNewTicket(string codes[], struct Ticket *p, int ctrTicket, int current
 	verifyIntInput(7, &p[ctrTicket].exitPoint, p[ctrTicket].inputTime, p[ctrTicket].entryPoint, "Drop-off Point code: ");
 }
 
-/* Inserts initial values in all bus units */
-void initializeBus(struct Bus *fleet)
-{
-	int schedule[20][2] = {            // List of bus schedules and corresponding departure time
-        // Manila to Laguna (101-109)
-        {101, 600}, {102, 730}, {103, 930}, {104, 1100}, {105, 1300}, {106, 1430}, {107, 1530}, {108, 1700}, {109, 1815},
-        // Laguna to Manila (150-160)
-        {150, 530}, {151, 545}, {152, 700}, {153, 730}, {154, 900}, {155, 1100}, {156, 1300}, {157, 1430}, {158, 1530}, {159, 1700}, {160, 1815}
-    };
-	
-	int ctrFleet, ctrUnit;
-	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
-	{
-		fleet[ctrFleet].busNum = schedule[ctrFleet][0];
-		fleet[ctrFleet].busTime = schedule[ctrFleet][1];
-		fleet[ctrFleet].limitType = BUS13_LIMIT;				// initializes all buses with 13-passenger config
-		for (ctrUnit = 0; ctrUnit < BUS16_LIMIT; ctrUnit++)		// all loads arrays can fit up to 16 passengers, but the system will limit the number of passengers to 13 passengers unless the limitType is changed
-		{
-			fleet[ctrFleet].load[ctrUnit].busNum = 0;
-			fleet[ctrFleet].load[ctrUnit].exitPoint = 0;
-		}
-	}
-}
 /* Displays all drop-off points on screen and number of passengers for each drop-off */
-void viewAllDropOffs(struct Ticket *p, string codes[], int currentDate, int ctrTicket)
+void viewAllDropOffs(const struct Bus *fleet, string codes[], int currentDate)
 {
-	int ctrPass = ctrTicket, ctrList, ctrLoc, ctrData, verifyCode;
+	int dropOffs[ROUTE_LIMIT];		// counted from the seats so that displaced passengers are not counted twice
+	int ctrList;
 	string exitKey;
 
 	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
@@ -788,31 +392,11 @@ void viewAllDropOffs(struct Ticket *p, string codes[], int currentDate, int ctrT
 
 	printf("\n\nCount\tDrop-off Point\n");
 
+	queryDropOffs(fleet, dropOffs);
+
 	for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)
 	{
-		ctrLoc = 0;
-		if (ctrPass > 0)	// refrains from calculating counts if no passengers are detected in the system
-		{
-			for (ctrData = 0; ctrData < ctrPass; ctrData++)
-			{
-				switch (p[ctrData].busNum)
-				{
-					case 108:
-					case 109:
-						verifyCode = verifyDropOff(p[ctrData].exitPoint, p[ctrData].inputTime, p[ctrData].entryPoint) - 1; // verifyDropOff will return the index + 1 of the drop-off code, so we must subtract by 1 to match the index numbering of the codes[] array of strings. This one also collects the passenger input time so that it would work with the verification for drop-off point code 104.
-						break;
-
-					default:
-						verifyCode = verifyDropOff(p[ctrData].exitPoint, -1, p[ctrData].entryPoint) - 1; // verifyDropOff will return the index + 1 of the drop-off code, so we must subtract by 1 to match the index numbering of the codes[] array of strings. This one disregards the input time.
-						break;
-				}
-
-				if (verifyCode == ctrList)
-					ctrLoc++;
-			}
-		}
-
-		printf("%d\t%s\n", ctrLoc, codes[ctrList]);
+		printf("%d\t%s\n", dropOffs[ctrList], codes[ctrList]);
 
 		if (ctrList == 4)
 			printf("\n");
@@ -823,7 +407,7 @@ void viewAllDropOffs(struct Ticket *p, string codes[], int currentDate, int ctrT
 	fgets(exitKey, sizeof(string), stdin);
 }
 /* Displays all passengers onboard a bus */
-void displayAllPassengers(string codes[], struct Bus *fleet, int ctrBus, int currentDate)
+void displayAllPassengers(string codes[], const struct Bus *fleet, int ctrBus, int currentDate)
 {
 	int ctrSelect = 1, ctrList, localLimit = fleet[ctrBus].limitType;
 
@@ -832,7 +416,7 @@ void displayAllPassengers(string codes[], struct Bus *fleet, int ctrBus, int cur
 		printf("\nSeat\tName of Passenger\n");
 		for (ctrList = 0; ctrList < localLimit; ctrList++)
 		{
-			if (fleet[ctrBus].load[ctrList].busNum != 0 && fleet[ctrBus].load[ctrList].exitPoint != 0)
+			if (checkSeat(fleet, ctrBus, ctrList))
 				printf("[%d]\t%s\n", ctrList + 1, fleet[ctrBus].load[ctrList].passName);
 			else
 				printf("[%d]\t%s\n", ctrList + 1, "Vacant");
@@ -849,7 +433,7 @@ void displayAllPassengers(string codes[], struct Bus *fleet, int ctrBus, int cur
 	system("cls");
 }
 /* Displays all buses in the bus fleet with passenger counts */
-void viewBusFleet(string codes[], struct Bus *fleet, int currentDate)
+void viewBusFleet(string codes[], const struct Bus *fleet, int currentDate)
 {
 	int ctrSelect = 1, ctrFleet = 0, localLimit = 0;
 
@@ -881,128 +465,582 @@ void viewBusFleet(string codes[], struct Bus *fleet, int currentDate)
 			printDate(currentDate);
 			printf("\n");
 
-			switch (localLimit)
+			if (localLimit > 0)
 			{
-				case BUS13_LIMIT:
-					printf("\nX indicates empty seats while O indicates filled seats.\n");
-					displayConfig13(fleet, ctrFleet);
-					break;
-				case BUS16_LIMIT:
-					printf("\nX indicates empty seats while O indicates filled seats.\n");
-					displayConfig16(fleet, ctrFleet);
-					break;
-				default:
-					printf("\n");
-					break;
+				printf("\nX indicates empty seats while O indicates filled seats.\n");
+				displayConfig(fleet, ctrFleet);
 			}
+			else
+				printf("\n");
 
 			displayAllPassengers(codes, fleet, ctrFleet, currentDate);
 		}
 	}
 }
-/* Generates a file name given a date */
-void generateTripFileName (string *fileName, int currentDate)
+/* Displays the seats left on the departures of a route within a time range and the earliest departure that a passenger of a given priority level can board */
+void viewSeatAvailability(const struct Bus *fleet, int currentDate)
 {
-	int month = currentDate / 1000000;
-	int day = (currentDate / 10000) % 100;
-	int year = currentDate % 10000;
-	string tempStr;
+	struct Availability result;
+	int entryPoint, startTime, endTime, priority, ctrFleet, ctrList, ctrDisplaceable = 0, earliestIndex;
+	string exitKey;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n");
 
-	strcpy(*fileName, "Trip-");
+	verifyIntInput(6, &entryPoint, -1, -1, "\n[1] Manila -> Laguna\n[2] Laguna -> Manila\nRoute of Trip: ");
+	verifyIntInput(2, &startTime, -1, -1, "Departures After (HHMM): ");
+	verifyIntInput(2, &endTime, -1, -1, "Latest Departure (HHMM): ");
+	verifyIntInput(5, &priority, -1, -1, "Priority Level (1-6): ");
 
-	if (day < 10)
-		strcat(*fileName, "0");
+	queryAvailability(fleet, entryPoint, startTime, endTime, &result);
+	for (ctrList = priority; ctrList < 6; ctrList++)	// passengers with a higher priority level number can be moved to a later trip
+		ctrDisplaceable += result.ctrPriority[ctrList];
+	earliestIndex = findEarliestSeat(fleet, entryPoint, startTime, priority);
 
-	snprintf(tempStr, sizeof(day), "%d", day);
-	strcat(*fileName, tempStr);
-	strcat(*fileName, "-");
+	system("cls");
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n\n%s, after ", returnOrigin(entryPoint == 1 ? 101 : 150));
+	printIn24H(startTime);
+	printf(" up to ");
+	printIn24H(endTime);
 
-	if (month < 10)
-		strcat(*fileName, "0");
-	snprintf(tempStr, sizeof(month), "%d", month);
-	strcat(*fileName, tempStr);
-	strcat(*fileName, "-");
+	printf("\n\nBus No.\t\tDeparture\tSeats Left\n");
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		if (checkRoute(fleet[ctrFleet].busNum, entryPoint) && fleet[ctrFleet].busTime > startTime && fleet[ctrFleet].busTime <= endTime)	// findEarliestSeat only takes departures after the start time too
+		{
+			printf("AE[%d]\t\t", fleet[ctrFleet].busNum);
+			printIn24H(fleet[ctrFleet].busTime);
+			printf("\t\t%d\n", getFullCapacity(fleet, ctrFleet) - checkBusLoad(fleet, ctrFleet, 1));
+		}
+	}
 
-	snprintf(tempStr, sizeof(year) + 1, "%d", year);
-	strcat(*fileName, tempStr);
-	strcat(*fileName, ".txt");
-}
-/* Fills the system database with bus and passenger data from a date-specific text file */
-void loadTripFile (struct Bus *fleet, struct Ticket *p, int currentDate, int *ctrTicket)
-{
-	string fileName, dumpStr;
-	int scanResult = 1;
-	generateTripFileName(&fileName, currentDate);
-	FILE *srcPtr = fopen(fileName, "r");
+	printf("\nDepartures: %d\nSeats left: %d\nSeats held by passengers below priority level %d: %d\nSeats held by groups, which are never moved: %d\n", result.ctrTrips, result.ctrFree, priority, ctrDisplaceable, result.ctrGrouped);
 
-	if (srcPtr == NULL)
+	if (earliestIndex >= 0)
 	{
-		fopen(fileName, "w");
-		printf("\n[SYSTEM] New trip file created.\n");
-		fclose(srcPtr);
+		printf("Earliest departure for priority level %d: AE%d at ", priority, fleet[earliestIndex].busNum);
+		printIn24H(fleet[earliestIndex].busTime);
+		printf("\n");
 	}
 	else
+		printf("Earliest departure for priority level %d: None\n", priority);
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Replays the trip files of a range of dates and displays the load factor per bus, drop-off demand by departure hour and the priority mix */
+void viewTripHistory(string codes[], int currentDate)
+{
+	struct Bus dayFleet[FLEET_LIMIT];		// bus container for the day being replayed
+	struct Ticket dayPass[DATABASE_LIMIT];	// passenger container for the day being replayed
+	int busPass[FLEET_LIMIT] = {0};			// total passengers carried by each bus
+	int busSeats[FLEET_LIMIT] = {0};		// total seats offered by each bus
+	int dropOffs[ROUTE_LIMIT] = {0};		// total passengers for each drop-off point
+	int hourDemand[24][2] = {{0}};			// total passengers by departure hour for each route
+	int priorityMix[6] = {0};				// total passengers for each priority level
+	int startDate, endDate, searchDate, ctrDays = 0, ctrTotal = 0;
+	int ctrTicket, ctrFleet, ctrLoad, ctrList;
+	int ctrRoute[2];
+	string fileName, exitKey;
+	FILE *srcPtr;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n\n");
+
+	verifyIntInput(1, &startDate, -1, -1, "Start Date (MMDDYYYY): ");
+	verifyIntInput(1, &endDate, -1, -1, "End Date (MMDDYYYY): ");
+
+	for (searchDate = startDate; getSortableDate(searchDate) <= getSortableDate(endDate); searchDate = getNextDate(searchDate))
 	{
-		//printf("\n[SYSTEM] File found. Reading...\n");
-		do 
+		generateTripFileName(&fileName, searchDate);
+		srcPtr = fopen(fileName, "r");
+
+		if (srcPtr != NULL)
 		{
-			scanResult = fscanf(srcPtr, "%s", dumpStr);
+			ctrTicket = 0;
+			initializeBus(dayFleet);
+			replayTripFile(srcPtr, dayFleet, dayPass, searchDate, &ctrTicket, ctrRoute);
+			fclose(srcPtr);
+			ctrDays++;
 
-			if (scanResult < 0)
-				system("cls");		// hides the last entry's loading message before displaying main menu
-			else
+			for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
 			{
-				printf("%s\n", dumpStr);
-				switch (dumpStr[0])
-				{
-					case 'M':
-					case 'm':
-						p[*ctrTicket].entryPoint = 1;
-						break;
-					case 'l':
-					case 'L':
-						p[*ctrTicket].entryPoint = 2;
-						break;
-					default:
-						break;
-				}
-				
-				fgetc(srcPtr);
-				fgets(p[*ctrTicket].passName, sizeof(string), srcPtr);			// get name with spaces
-				p[*ctrTicket].passName[strlen(p[*ctrTicket].passName) - 1] = '\0'; // remove newline
-				printf("%s\n", p[*ctrTicket].passName); // store name
-
-				fscanf(srcPtr, "%d\n", &p[*ctrTicket].idNum); // store ID number
-				printf("%d\n", p[*ctrTicket].idNum);
-				fscanf(srcPtr, "%d\n", &p[*ctrTicket].priority); // store priority number
-				printf("%d\n", p[*ctrTicket].priority);
-				fscanf(srcPtr, "%d\n", &p[*ctrTicket].inputTime); // store time of input
-				printf("%d\n", p[*ctrTicket].inputTime);
-				fscanf(srcPtr, "%s\n", dumpStr); 					// skip bus number
-				fscanf(srcPtr, "%s\n", dumpStr); 					// skip bus configuration
-				fscanf(srcPtr, "%s\n", dumpStr);					// skip bus seat index
-				fscanf(srcPtr, "%d\n", &p[*ctrTicket].exitPoint);	// store drop off code
-				printf("%d\n", p[*ctrTicket].exitPoint);
-
-				p[*ctrTicket].inputDate = currentDate;										// store date of input
-				//printf("scanResult: %d\tctrTicket: %d\n", scanResult, *ctrTicket);
-				assignToSeat(fleet, p, findMatchingTime(fleet, p, *ctrTicket), *ctrTicket, "0"); // assign seat but dont save to file
-
-				(*ctrTicket)++;
-			}
+				busPass[ctrFleet] += checkBusLoad(dayFleet, ctrFleet, 1);
+				busSeats[ctrFleet] += dayFleet[ctrFleet].limitType;
+				countBusDropOffs(dayFleet, ctrFleet, dropOffs);
 
-			//displayAllBuses(fleet);
+				for (ctrLoad = 0; ctrLoad < dayFleet[ctrFleet].limitType; ctrLoad++)
+				{
+					if (checkSeat(dayFleet, ctrFleet, ctrLoad))
+					{
+						if (dayFleet[ctrFleet].load[ctrLoad].entryPoint >= 1 && dayFleet[ctrFleet].load[ctrLoad].entryPoint <= 2)
+							hourDemand[dayFleet[ctrFleet].busTime / 100][dayFleet[ctrFleet].load[ctrLoad].entryPoint - 1]++;
+
+						if (dayFleet[ctrFleet].load[ctrLoad].priority >= 1 && dayFleet[ctrFleet].load[ctrLoad].priority <= 6)
+							priorityMix[dayFleet[ctrFleet].load[ctrLoad].priority - 1]++;
+
+						ctrTotal++;
+					}
+				}
+			}
+		}
+	}
+
+	system("cls");
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nTrip History: ");
+	printDate(startDate);
+	printf(" to ");
+	printDate(endDate);
+	printf("\nTrip files found: %d\nPassengers carried: %d\n", ctrDays, ctrTotal);
+
+	if (ctrDays > 0)
+	{
+		printf("\nBus No.\t\tDeparture\tPassengers\tLoad Factor\n");
+		for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+		{
+			printf("AE[%d]\t\t", dayFleet[ctrFleet].busNum);
+			printIn24H(dayFleet[ctrFleet].busTime);
+			printf("\t\t%d\t\t%d%%\n", busPass[ctrFleet], busPass[ctrFleet] * 100 / busSeats[ctrFleet]);
+
+			if (ctrFleet == 8) // creates a newline divider between Manila and Laguna bound buses
+				printf("\n");
+		}
+
+		printf("\nDeparture Hour\t%s\t%s\n", returnOrigin(101), returnOrigin(150));
+		for (ctrList = 0; ctrList < 24; ctrList++)
+		{
+			if (hourDemand[ctrList][0] > 0 || hourDemand[ctrList][1] > 0)
+			{
+				printIn24H(ctrList * 100);
+				printf("\t\t%d\t\t\t%d\n", hourDemand[ctrList][0], hourDemand[ctrList][1]);
+			}
+		}
+
+		printf("\nCount\tDrop-off Point\n");
+		for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)
+		{
+			printf("%d\t%s\n", dropOffs[ctrList], codes[ctrList]);
+
+			if (ctrList == 4)
+				printf("\n");
+		}
+
+		printf("\nCount\tPriority Level\n");
+		for (ctrList = 0; ctrList < 6; ctrList++)
+			printf("%d\t%d\n", priorityMix[ctrList], ctrList + 1);
+	}
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+
+/* Replays the trip files of a range of dates under every capacity policy and demand level and displays the outcome of each scenario */
+void viewCapacitySimulation(int currentDate)
+{
+	struct Bus dayFleet[FLEET_LIMIT];		// bus container for the day being read
+	struct Ticket dayPass[DATABASE_LIMIT];	// bookings of the day being read
+	struct Simulation dayResult;
+	struct Simulation totals[2][POLICY_LIMIT][3];	// totals for each schedule, policy and demand level
+	int demandLevels[3] = {100, 125, 150};		// demand as a percentage of the recorded bookings
+	string policyNames[POLICY_LIMIT] = {"13 to 16", "All 16", "All 13"};
+	string scheduleNames[2] = {"Current", "File"};
+	int altSchedule[FLEET_LIMIT][3];			// schedule read from the file being compared with the active schedule
+	int startDate, endDate, searchDate, ctrDays = 0, ctrSchedules = 1, scheduleResult;
+	int ctrTicket, ctrSchedule, ctrPolicy, ctrDemand;
+	int ctrRoute[2];
+	string fileName, scheduleName, exitKey;
+	struct Simulation *total;
+	FILE *srcPtr;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n\n");
+
+	verifyIntInput(1, &startDate, -1, -1, "Start Date (MMDDYYYY): ");
+	verifyIntInput(1, &endDate, -1, -1, "End Date (MMDDYYYY): ");
+
+	printf("Schedule File to Compare ([0] for none): ");
+	fgetc(stdin);
+	fgets(scheduleName, sizeof(string), stdin);
+	scheduleName[strlen(scheduleName) - 1] = '\0'; // remove newline
+
+	if (strcmp(scheduleName, "0") != 0)
+	{
+		scheduleResult = readScheduleFile(scheduleName, altSchedule);
+		if (scheduleResult == SCHEDULE_OK)
+			ctrSchedules = 2;
+		else if (scheduleResult == SCHEDULE_MISSING)
+			printf("\n[ERROR] \"%s\" was not found. Only the current bus schedule is simulated.\n", scheduleName);
+		else
+			printf("\n[ERROR] Line %d of \"%s\" is not a valid \"<bus number> <departure time> <seats>\" entry, or a bus is listed twice or left out.\nA schedule lists each of the %d buses AE101 to AE109 and AE150 to AE160 exactly once. Only the current bus schedule is simulated.\n", scheduleResult, scheduleName, FLEET_LIMIT);
+	}
+
+	memset(totals, 0, sizeof(totals));
+	for (searchDate = startDate; getSortableDate(searchDate) <= getSortableDate(endDate); searchDate = getNextDate(searchDate))
+	{
+		generateTripFileName(&fileName, searchDate);
+		srcPtr = fopen(fileName, "r");
+
+		if (srcPtr != NULL)
+		{
+			ctrTicket = 0;
+			initializeBus(dayFleet);
+			replayTripFile(srcPtr, dayFleet, dayPass, searchDate, &ctrTicket, ctrRoute);
+			fclose(srcPtr);
+			ctrDays++;
+
+			for (ctrSchedule = 0; ctrSchedule < ctrSchedules; ctrSchedule++)
+			{
+				for (ctrPolicy = 0; ctrPolicy < POLICY_LIMIT; ctrPolicy++)
+				{
+					for (ctrDemand = 0; ctrDemand < 3; ctrDemand++)
+					{
+						simulateDay(dayPass, ctrTicket, ctrSchedule == 0 ? NULL : altSchedule, ctrPolicy + 1, demandLevels[ctrDemand], &dayResult);
+						total = &totals[ctrSchedule][ctrPolicy][ctrDemand];
+						total->ctrRequests += dayResult.ctrRequests;
+						total->ctrServed += dayResult.ctrServed;
+						total->ctrRejected += dayResult.ctrRejected;
+						total->ctrUnserved += dayResult.ctrUnserved;
+						total->ctrDisplaced += dayResult.ctrDisplaced;
+						total->ctrConverted += dayResult.ctrConverted;
+						total->ctrSeats += dayResult.ctrSeats;
+						if (dayResult.maxCascade > total->maxCascade)
+							total->maxCascade = dayResult.maxCascade;
+					}
+				}
+			}
+		}
+	}
+
+	system("cls");
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCapacity Simulation: ");
+	printDate(startDate);
+	printf(" to ");
+	printDate(endDate);
+	printf("\nTrip files found: %d\n", ctrDays);
+
+	if (ctrDays > 0)
+	{
+		printf("\nSchedule\tPolicy\t\tDemand\tBooked\tServed\tRejected\tDisplaced\tLongest Cascade\tUnserved\tConversions\tLoad Factor\n");
+		for (ctrSchedule = 0; ctrSchedule < ctrSchedules; ctrSchedule++)
+		{
+			for (ctrPolicy = 0; ctrPolicy < POLICY_LIMIT; ctrPolicy++)
+			{
+				for (ctrDemand = 0; ctrDemand < 3; ctrDemand++)
+				{
+					total = &totals[ctrSchedule][ctrPolicy][ctrDemand];
+					printf("%s\t\t%s\t%d%%\t%d\t%d\t%d\t\t%d\t\t%d\t\t%d\t\t%d\t\t%d%%\n", scheduleNames[ctrSchedule], policyNames[ctrPolicy], demandLevels[ctrDemand],
+						total->ctrRequests, total->ctrServed, total->ctrRejected, total->ctrDisplaced, total->maxCascade, total->ctrUnserved,
+						total->ctrConverted, total->ctrServed * 100 / total->ctrSeats);
+				}
+				printf("\n");
+			}
+		}
+	}
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Asks for the scope and format of a passenger manifest and exports it to a file */
+void exportManifestMenu(string codes[], const struct Bus *fleet, int currentDate)
+{
+	int exportScope, exportFormat, busNum = 0, entryPoint = 0, ctrPass;
+	string fileName, exitKey;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n");
+
+	verifyIntInput(13, &exportScope, 3, -1, "\n[1] One bus\n[2] One route\n[3] Whole day\nManifest Scope: ");
+	switch (exportScope)
+	{
+		case 1:
+			do
+				verifyIntInput(11, &busNum, -1, -1, "Bus Number (1xx): ");
+			while (busNum == 0);
+			break;
+		case 2:
+			verifyIntInput(6, &entryPoint, -1, -1, "\n[1] Manila -> Laguna\n[2] Laguna -> Manila\nRoute of Trip: ");
+			break;
+		default:
+			break;
+	}
+	verifyIntInput(13, &exportFormat, 2, -1, "\n[1] CSV\n[2] JSON\nFile Format: ");
+
+	generateManifestFileName(&fileName, currentDate, busNum, exportFormat);
+	ctrPass = exportManifest(fleet, codes, currentDate, busNum, entryPoint, exportFormat, fileName);
+
+	if (ctrPass < 0)
+		printf("\n[ERROR] A writing error was detected while writing to file \"%s\".\n", fileName);
+	else
+		printf("\n[SYSTEM] %d passenger(s) exported to \"%s\".\n", ctrPass, fileName);
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Displays the outcome of a reservation */
+void displayReservation(const struct Ticket *p, const struct Reservation *result)
+{
+	switch (result->status)
+	{
+		case RESERVE_OK:
+			system("cls");
+			if (result->ctrConverted > 0)
+				printf("\n[SYSTEM] %d bus(es) have been converted into a larger seat configuration.\n", result->ctrConverted);
+			if (result->ctrDisplaced > 0)
+				printf("\n[SYSTEM] %d lower priority passenger(s) have been moved to later trips to accomodate this passenger.\n", result->ctrDisplaced);
+			if (result->unservedNum >= 0)
+				printf("\n[SYSTEM] Passenger #%d with priority level %d has no more elligible trips for the day.\n", result->unservedNum + 1, p[result->unservedNum].priority);
+			printf("\n[SYSTEM] Passenger #%d is elligible to board AE%d at ", result->ticketNum + 1, result->busNum);
+			printIn24H(result->busTime);
+			printf(".\n");
+			break;
+		case RESERVE_NO_TRIP:
+			system("cls");
+			printf("\n[SYSTEM] No more elligible trips for the day!\n");
+			break;
+		case RESERVE_NO_SEAT:
+			system("cls");
+			printf("\n[SYSTEM] All elligible trips are full of passengers with the same or higher priority level.\n");
+			break;
+		default:
+			printf("\n[ERROR] The passenger details are invalid. The ticket was not saved.\n");
+			break;
+	}
+}
+/* Displays the outcome of every request released from the admission queue */
+void displayAdmission(const struct Ticket *p, const struct Ticket *admitted, const struct Reservation *results, int ctrReleased)
+{
+	int ctrList, ctrDisplaced = 0, ctrConverted = 0;
+
+	printf("\n[SYSTEM] %d queued passenger(s) released by priority level.\n\nTicket\tPriority\tResult\t\tName of Passenger\n", ctrReleased);
+	for (ctrList = 0; ctrList < ctrReleased; ctrList++)
+	{
+		switch (results[ctrList].status)
+		{
+			case RESERVE_OK:
+				printf("#%d\t%d\t\tAE%d ", results[ctrList].ticketNum + 1, admitted[ctrList].priority, results[ctrList].busNum);
+				printIn24H(results[ctrList].busTime);
+				ctrDisplaced += results[ctrList].ctrDisplaced;
+				ctrConverted += results[ctrList].ctrConverted;
+				if (results[ctrList].unservedNum >= 0)
+					printf("\t%s\n[SYSTEM] Passenger #%d with priority level %d has no more elligible trips for the day.\n", admitted[ctrList].passName, results[ctrList].unservedNum + 1, p[results[ctrList].unservedNum].priority);
+				else
+					printf("\t%s\n", admitted[ctrList].passName);
+				break;
+			case RESERVE_NO_TRIP:
+				printf("-\t%d\t\tNo trip\t\t%s\n", admitted[ctrList].priority, admitted[ctrList].passName);
+				break;
+			case RESERVE_NO_SEAT:
+				printf("-\t%d\t\tNo seat\t\t%s\n", admitted[ctrList].priority, admitted[ctrList].passName);
+				break;
+			default:
+				printf("-\t%d\t\tNot saved\t%s\n", admitted[ctrList].priority, admitted[ctrList].passName);
+				break;
 		}
-		while (scanResult > 0 && *ctrTicket < DATABASE_LIMIT);
+	}
+
+	if (ctrConverted > 0)
+		printf("\n[SYSTEM] %d bus(es) have been converted into a larger seat configuration.\n", ctrConverted);
+	if (ctrDisplaced > 0)
+		printf("\n[SYSTEM] %d lower priority passenger(s) have been moved to later trips.\n", ctrDisplaced);
+}
+/* Asks the user for several passengers, holds them in the admission queue and seats them by priority level once the window closes or the queue is full */
+void encodeAdmissionQueue(string codes[], struct Bus *fleet, struct Ticket *p, int *ctrTicket, int currentDate, string fileName)
+{
+	struct AdmissionQueue queue;
+	struct Ticket request[1];						// passenger being encoded, seated only once the queue is released
+	struct Ticket admitted[ADMISSION_LIMIT];
+	struct Reservation results[ADMISSION_LIMIT];
+	int windowLength, ctrChoice = 1, queueResult, ctrReleased;
+	string exitKey;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n\n");
+	verifyIntInput(13, &windowLength, 60, -1, "Admission Window in Minutes (1-60): ");
+	initializeAdmission(&queue, windowLength, ADMISSION_DEPTH);
 
-		fclose(srcPtr);
+	while (ctrChoice == 1 && *ctrTicket + queue.ctrPending < DATABASE_LIMIT)
+	{
+		system("cls");
+		inputNewTicket(codes, request, 0, currentDate);
 
-		if (scanResult == -2)
-			printf("\n[ERROR] A reading error was encountered when attempting to read \"%s\".\n", fileName);
+		queueResult = queueTicket(&queue, &request[0]);
+		if (queueResult == RESERVE_BUSY)			// the oldest request has waited out the window or the queue is full, so it is released before this one is held
+		{
+			ctrReleased = releaseAdmission(&queue, fleet, p, ctrTicket, fileName, admitted, results);
+			displayAdmission(p, admitted, results, ctrReleased);
+			queueResult = queueTicket(&queue, &request[0]);
+		}
+
+		if (queueResult == RESERVE_OK)
+			printf("\n[SYSTEM] Passenger held in the admission queue. %d passenger(s) waiting.\n", queue.ctrPending);
 		else
-			printf("\n[SYSTEM] Loading complete.\n");
+			printf("\n[ERROR] The passenger details are invalid. The ticket was not saved.\n");
+
+		verifyIntInput(13, &ctrChoice, 2, -1, "\n[1] Encode another passenger\n[2] Release the queue and return to the main menu\nInput: ");
 	}
-	
+
+	if (*ctrTicket + queue.ctrPending >= DATABASE_LIMIT)
+		printf("\n[SYSTEM] The system has reached the maximum number of passengers for the day.\n");
+
+	ctrReleased = releaseAdmission(&queue, fleet, p, ctrTicket, fileName, admitted, results);
+	displayAdmission(p, admitted, results, ctrReleased);
+	publishFleetStatus(fleet, currentDate);
+	saveSnapshot(fleet, currentDate);
+	shipTripFile(currentDate);
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Asks the user for the members of a group travelling together and seats them all on the same trip */
+void encodeGroup(string codes[], struct Bus *fleet, struct Ticket *p, int *ctrTicket, int currentDate, string fileName)
+{
+	struct Ticket group[GROUP_LIMIT];
+	struct Reservation results[GROUP_LIMIT];
+	int groupSize, inputTime, entryPoint, ctrMember, groupResult;
+	string exitKey;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n\n");
+
+	verifyIntInput(13, &groupSize, GROUP_LIMIT, -1, "Number of Passengers in the Group: ");
+	verifyIntInput(2, &inputTime, -1, -1, "Current 24-Hour Time (HHMM): ");
+	verifyIntInput(6, &entryPoint, -1, -1, "\n[1] Manila -> Laguna\n[2] Laguna -> Manila\nRoute of Trip: ");
+
+	for (ctrMember = 0; ctrMember < groupSize; ctrMember++)
+	{
+		group[ctrMember].inputDate = currentDate;
+		group[ctrMember].inputTime = inputTime;
+		group[ctrMember].entryPoint = entryPoint;
+
+		printf("\nPassenger %d of %d\nName of Passenger: ", ctrMember + 1, groupSize);
+		fgetc(stdin);
+		fgets(group[ctrMember].passName, sizeof(string), stdin);
+		group[ctrMember].passName[strlen(group[ctrMember].passName) - 1] = '\0'; // remove newline
+
+		verifyIntInput(4, &group[ctrMember].idNum, -1, -1, "ID Number: ");
+		verifyIntInput(5, &group[ctrMember].priority, -1, -1, "Priority Level (1-6): ");
+		displayAllRoutes(codes, entryPoint, inputTime);
+		verifyIntInput(7, &group[ctrMember].exitPoint, inputTime, entryPoint, "Drop-off Point code: ");
+	}
+
+	system("cls");
+	groupResult = reserveGroup(fleet, p, ctrTicket, group, groupSize, fileName, results);
+	switch (groupResult)
+	{
+		case RESERVE_OK:
+			publishFleetStatus(fleet, currentDate);
+			saveSnapshot(fleet, currentDate);
+			shipTripFile(currentDate);
+			if (results[0].ctrConverted > 0)
+				printf("\n[SYSTEM] AE%d has been converted into a larger seat configuration to keep the group together.\n", results[0].busNum);
+			printf("\n[SYSTEM] The group of %d is elligible to board AE%d at ", groupSize, results[0].busNum);
+			printIn24H(results[0].busTime);
+			printf(".\n\nTicket\tSeat\tName of Passenger\n");
+			for (ctrMember = 0; ctrMember < groupSize; ctrMember++)
+				printf("#%d\t%d\t%s\n", results[ctrMember].ticketNum + 1, results[ctrMember].seatNum + 1, group[ctrMember].passName);
+			break;
+		case RESERVE_NO_TRIP:
+			printf("\n[SYSTEM] No more elligible trips for the day!\n");
+			break;
+		case RESERVE_NO_SEAT:
+			printf("\n[SYSTEM] No elligible trip has %d vacant seats for the group. No ticket was saved.\n", groupSize);
+			break;
+		default:
+			printf("\n[ERROR] The group details are invalid or the system is full. No ticket was saved.\n");
+			break;
+	}
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Displays the outcome of reading the schedule file */
+void displayScheduleResult(int scheduleResult)
+{
+	switch (scheduleResult)
+	{
+		case SCHEDULE_OK:
+			printf("\n[SYSTEM] Bus schedule loaded from \"%s\".\n", SCHEDULE_FILE);
+			break;
+		case SCHEDULE_MISSING:
+			printf("\n[SYSTEM] \"%s\" was not found. The current bus schedule is kept.\n", SCHEDULE_FILE);
+			break;
+		case SCHEDULE_STRANDED:
+			printf("\n[ERROR] Some passengers would have no trip on the new schedule. The current bus schedule is kept.\n");
+			break;
+		case SCHEDULE_TRIP_ERROR:
+			printf("\n[ERROR] The trip file could not be replayed on the new schedule. The current bus schedule is kept.\n");
+			break;
+		default:
+			printf("\n[ERROR] Line %d of \"%s\" is not a valid \"<bus number> <departure time> <seats>\" entry, or a bus is listed twice or left out.\nA schedule lists each of the %d buses AE101 to AE109 and AE150 to AE160 exactly once. Trips can be retimed or given another vehicle, but not added or removed.\nThe current bus schedule is kept.\n", scheduleResult, SCHEDULE_FILE, FLEET_LIMIT);
+			break;
+	}
+}
+/* Reloads the bus schedule file while the day is running and lists the passengers whose trip changed */
+void reloadScheduleMenu(struct Bus *fleet, struct Ticket *p, int *ctrTicket, int currentDate)
+{
+	int movedTickets[DATABASE_LIMIT];
+	int scheduleResult, ctrMoved = 0, ctrList;
+	struct BusInfo info;
+	string exitKey;
+
+	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
+	printDate(currentDate);
+	printf("\n");
+
+	scheduleResult = reloadSchedule(fleet, p, ctrTicket, currentDate, SCHEDULE_FILE, movedTickets, &ctrMoved);
+	displayScheduleResult(scheduleResult);
+
+	if (scheduleResult == SCHEDULE_OK)
+	{
+		publishFleetStatus(fleet, currentDate);
+		saveSnapshot(fleet, currentDate);
+		printf("\n[SYSTEM] %d passenger(s) have a new trip.\n", ctrMoved);
+		if (ctrMoved > 0)
+			printf("\nTicket\tNew Trip\t\tName of Passenger\n");
+		for (ctrList = 0; ctrList < ctrMoved; ctrList++)
+		{
+			printf("#%d\t", movedTickets[ctrList] + 1);
+			if (queryBus(fleet, p[movedTickets[ctrList]].busNum, &info) >= 0)
+			{
+				printf("AE%d ", info.busNum);
+				printIn24H(info.busTime);
+			}
+			else
+				printf("None\t");
+			printf("\t%s\n", p[movedTickets[ctrList]].passName);
+		}
+	}
+
+	printf("\nEnter any character to return to the main menu.\nInput: ");
+	fgetc(stdin);
+	fgets(exitKey, sizeof(string), stdin);
+}
+/* Displays the outcome of loading the trip file */
+void displayLoadResult(int loadResult, int currentDate, int ctrTicket, int *ctrRoute)
+{
+	string fileName;
+	generateTripFileName(&fileName, currentDate);
+
+	if (loadResult < 0)
+		printf("\n[SYSTEM] New trip file created.\n");
+	else if (loadResult > 0)
+		printf("\n[ERROR] A malformed record was found on line %d of \"%s\". Only the %d ticket(s) before it were restored.\n", loadResult, fileName, ctrTicket);
+	else
+		printf("\n[SYSTEM] Loading complete. %d %s and %d %s ticket(s) restored.\n", ctrRoute[0], returnOrigin(101), ctrRoute[1], returnOrigin(150));
 }
 
 /* MAIN MENU FUNCTIONS */
@@ -1012,12 +1050,16 @@ void displayMenuOptions(int currentDate, int ctrTicket)
 	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\nCurrent Date: ");
 	printDate(currentDate);
 	printf("\nCurrent Passenger Count: %d\n", ctrTicket);
-	printf("\n[1] Encode Passenger\n[2] View Bus and Passenger Info\n[3] View Route and Drop-Off Point Info\n[4] Exit\n\n");
+	printf("\n[1] Encode Passenger\n[2] View Bus and Passenger Info\n[3] View Route and Drop-Off Point Info\n[4] View Trip History\n[5] Check Seat Availability\n[6] Simulate Capacity Policies\n[7] Export Passenger Manifest\n[8] Encode Passenger Queue\n[9] Reload Bus Schedule\n[10] Encode Passenger Group\n[11] Exit\n\n");
 }
 /* Displays main menu and handles user input for menu options */
 int displayMenu(int currentDate, int *ctrMenu, int *ctrTicket, int *ctrInit, struct Bus *fleet, struct Ticket *p)
 {
 	string fileName;				// pointer for the destination file name
+	struct Reservation result;		// outcome of a new booking
+	int loadResult;					// outcome of loading the trip file
+	int ctrRoute[2] = {0, 0};		// number of tickets restored for each route
+	int scheduleResult;				// outcome of reading the schedule file
 	string codes[ROUTE_LIMIT] = {
 		// MNL-LAG via SLEX Mamplasan Exit (101-104)
 		"[101] SLEX Mamplasan Exit", "[102] San Jose Village Phase 5", "[103/112] DLSU-STC Milagros Del Rosario (MRR) Building - East Canopy", "[104] Phoenix Gas Station, Sta. Rosa-Tagaytay Rd.", // 104 is only for AE108 & AE109
@@ -1031,7 +1073,17 @@ int displayMenu(int currentDate, int *ctrMenu, int *ctrTicket, int *ctrInit, str
 
 	if (*ctrInit)
 	{
-		loadTripFile(fleet, p, currentDate, ctrTicket);
+		scheduleResult = loadSchedule(fleet, SCHEDULE_FILE);
+		if (scheduleResult != SCHEDULE_MISSING)		// the built-in schedule is used without a schedule file
+			displayScheduleResult(scheduleResult);
+		if (restoreTripFile(currentDate))
+			printf("\n[SYSTEM] Trip file restored from the standby copy.\n");
+		loadResult = loadTripFile(fleet, p, currentDate, ctrTicket, ctrRoute);		// loaded before displaying so that the ticket count is up to date
+		displayLoadResult(loadResult, currentDate, *ctrTicket, ctrRoute);
+		publishFleetStatus(fleet, currentDate);
+		saveSnapshot(fleet, currentDate);
+		if (shipTripFile(currentDate) < 0)
+			printf("\n[SYSTEM] The standby copy in \"%s\" cannot be reached. It will be updated once it is available.\n", STANDBY_DIRECTORY);
 		*ctrInit = 0;
 	}
 
@@ -1042,9 +1094,20 @@ int displayMenu(int currentDate, int *ctrMenu, int *ctrTicket, int *ctrInit, str
 	{
 		case 1:
 			system("cls");
-			inputNewTicket(codes, p, *ctrTicket, currentDate);
-			assignToSeat(fleet, p, findMatchingTime(fleet, p, *ctrTicket), *ctrTicket, fileName);
-			(*ctrTicket)++;
+			if (*ctrTicket < DATABASE_LIMIT)
+			{
+				inputNewTicket(codes, p, *ctrTicket, currentDate);
+				if (reserveTicket(fleet, p, *ctrTicket, fileName, &result) == RESERVE_OK)
+				{
+					(*ctrTicket)++;
+					publishFleetStatus(fleet, currentDate);
+					saveSnapshot(fleet, currentDate);
+					shipTripFile(currentDate);		// catches up on any records missed while the standby copy was unreachable
+				}
+				displayReservation(p, &result);
+			}
+			else
+				printf("\n[ERROR] The system has reached the maximum number of passengers for the day.\n");
 			break;
 		case 2:
 			system("cls");
@@ -1053,7 +1116,42 @@ int displayMenu(int currentDate, int *ctrMenu, int *ctrTicket, int *ctrInit, str
 			break;
 		case 3:
 			system("cls");
-			viewAllDropOffs(p, codes, currentDate, *ctrTicket);
+			viewAllDropOffs(fleet, codes, currentDate);
+			system("cls");
+			break;
+		case 4:
+			system("cls");
+			viewTripHistory(codes, currentDate);
+			system("cls");
+			break;
+		case 5:
+			system("cls");
+			viewSeatAvailability(fleet, currentDate);
+			system("cls");
+			break;
+		case 6:
+			system("cls");
+			viewCapacitySimulation(currentDate);
+			system("cls");
+			break;
+		case 7:
+			system("cls");
+			exportManifestMenu(codes, fleet, currentDate);
+			system("cls");
+			break;
+		case 8:
+			system("cls");
+			encodeAdmissionQueue(codes, fleet, p, ctrTicket, currentDate, fileName);
+			system("cls");
+			break;
+		case 9:
+			system("cls");
+			reloadScheduleMenu(fleet, p, ctrTicket, currentDate);
+			system("cls");
+			break;
+		case 10:
+			system("cls");
+			encodeGroup(codes, fleet, p, ctrTicket, currentDate, fileName);
 			system("cls");
 			break;
 		case MENU_EXIT_OPTION:
@@ -1067,14 +1165,127 @@ int displayMenu(int currentDate, int *ctrMenu, int *ctrTicket, int *ctrInit, str
 	return *ctrMenu;
 }
 
+/* COMMAND-LINE QUERY FUNCTIONS */
+/* Prints the load and the occupied seats of a bus. Returns 0 if the bus exists, otherwise 1. */
+int printBusQuery(const struct Bus *fleet, int busNum)
+{
+	struct BusInfo info;
+	int ctrBus = queryBus(fleet, busNum, &info), ctrLoad;
+
+	if (ctrBus < 0)
+		return 1;
+
+	// BUS <bus number> <departure time> <limit type> <passengers>
+	printf("BUS %d %04d %d %d\n", info.busNum, info.busTime, info.limitType, info.ctrUsed);
+	for (ctrLoad = 0; ctrLoad < fleet[ctrBus].limitType; ctrLoad++)
+	{
+		// SEAT <seat number> <ticket number> <ID number> <priority level> <drop-off code> <name>
+		if (checkSeat(fleet, ctrBus, ctrLoad))
+			printf("SEAT %d %d %d %d %d %s\n", ctrLoad + 1, fleet[ctrBus].load[ctrLoad].origNum + 1, fleet[ctrBus].load[ctrLoad].idNum,
+				   fleet[ctrBus].load[ctrLoad].priority, fleet[ctrBus].load[ctrLoad].exitPoint, fleet[ctrBus].load[ctrLoad].passName);
+	}
+
+	return 0;
+}
+/* Prints the number of passengers for each drop-off point. Returns 0. */
+int printDropOffQuery(const struct Bus *fleet)
+{
+	int validCodes[ROUTE_LIMIT] = {101, 102, 103, 104, 111, 201, 221, 222, 223, 224};
+	int dropOffs[ROUTE_LIMIT];
+	int ctrList;
+
+	queryDropOffs(fleet, dropOffs);
+	for (ctrList = 0; ctrList < ROUTE_LIMIT; ctrList++)		// DROPOFF <drop-off code> <passengers> <name>
+		printf("DROPOFF %d %d %s\n", validCodes[ctrList], dropOffs[ctrList], returnDropOff(ctrList));
+
+	return 0;
+}
+/* Prints every seated ticket with the given ID number. Returns 0 if one was found, otherwise 1. */
+int printIDQuery(const struct Bus *fleet, int idNum)
+{
+	int ctrFleet, ctrLoad, isFound = 0;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)
+	{
+		for (ctrLoad = 0; ctrLoad < fleet[ctrFleet].limitType; ctrLoad++)
+		{
+			if (checkSeat(fleet, ctrFleet, ctrLoad) && fleet[ctrFleet].load[ctrLoad].idNum == idNum)
+			{
+				// TICKET <ticket number> <bus number> <departure time> <seat number> <priority level> <name>
+				printf("TICKET %d %d %04d %d %d %s\n", fleet[ctrFleet].load[ctrLoad].origNum + 1, fleet[ctrFleet].busNum, fleet[ctrFleet].busTime,
+					   ctrLoad + 1, fleet[ctrFleet].load[ctrLoad].priority, fleet[ctrFleet].load[ctrLoad].passName);
+				isFound = 1;
+			}
+		}
+	}
+
+	return !isFound;
+}
+/* Prints the load of every bus. Returns 0. */
+int printLoadQuery(const struct Bus *fleet)
+{
+	int ctrFleet;
+
+	for (ctrFleet = 0; ctrFleet < FLEET_LIMIT; ctrFleet++)		// BUS <bus number> <departure time> <limit type> <passengers>
+		printf("BUS %d %04d %d %d\n", fleet[ctrFleet].busNum, fleet[ctrFleet].busTime, fleet[ctrFleet].limitType, checkBusLoad(fleet, ctrFleet, 1));
+
+	return 0;
+}
+/* Answers a single query given on the command line without reading from stdin. Returns 0 if answered, 1 if nothing was found, or 2 if the query is invalid. */
+int runQuery(int argc, char *argv[])
+{
+	struct Bus fleet[FLEET_LIMIT];
+	time_t currentTime = time(NULL);
+	struct tm *localDate = localtime(&currentTime);
+	int currentDate = (localDate->tm_mon + 1) * 1000000 + localDate->tm_mday * 10000 + localDate->tm_year + 1900;	// today unless --date is given
+	int ctrArg, argValue = 0, ctrValues = 0;
+
+	for (ctrArg = 2; ctrArg < argc; ctrArg++)
+	{
+		if (strcmp(argv[ctrArg], "--date") == 0 && ctrArg + 1 < argc)
+			currentDate = atoi(argv[++ctrArg]);
+		else
+		{
+			argValue = atoi(argv[ctrArg]);
+			ctrValues++;
+		}
+	}
+
+	if (!(checkIfDay(currentDate, getDaysInMonth(currentDate)) && checkIfMonth(currentDate)))
+	{
+		fprintf(stderr, "Invalid date. Dates are written as MMDDYYYY.\n");
+		return 2;
+	}
+
+	loadSnapshot(fleet, currentDate);
+
+	if (strcmp(argv[1], "bus") == 0 && ctrValues == 1)
+		return printBusQuery(fleet, argValue);
+	else if (strcmp(argv[1], "dropoffs") == 0 && ctrValues == 0)
+		return printDropOffQuery(fleet);
+	else if (strcmp(argv[1], "find-id") == 0 && ctrValues == 1)
+		return printIDQuery(fleet, argValue);
+	else if (strcmp(argv[1], "load") == 0 && ctrValues == 0)
+		return printLoadQuery(fleet);
+
+	fprintf(stderr, "Usage: %s bus <bus number> | dropoffs | find-id <ID number> | load [--date MMDDYYYY]\n       %s --trace\n", argv[0], argv[0]);
+	return 2;
+}
+
 /* START FUNCTION */
-int main()
+int main(int argc, char *argv[])
 {
-	int ctrMenu = 0, ctrTicket = 0, ctrInit = 1, currentDate;
+	int ctrMenu = 0, ctrTicket = 0, ctrInit = 1, currentDate, ctrSpans;
+	int isTracing = argc > 1 && strcmp(argv[1], "--trace") == 0;	// records the time taken by each booking step until the program exits
+	string traceName;
 
 	struct Bus fleet[FLEET_LIMIT];
 	struct Ticket p[DATABASE_LIMIT];
 
+	if (argc > 1 && !isTracing)			// answers a query from the command line instead of opening the menu
+		return runQuery(argc, argv);
+	enableTrace(isTracing);
+
 	initializeBus(fleet);
 	system("cls");
 	printf("\nDe La Salle University\nArrows Express Line Embarkation System\n\n");
@@ -1083,5 +1294,15 @@ int main()
 
 	while (displayMenu(currentDate, & ctrMenu, &ctrTicket, &ctrInit, fleet, p) != MENU_EXIT_OPTION);
 
+	if (isTracing)
+	{
+		generateTraceFileName(&traceName, currentDate);
+		ctrSpans = exportTrace(traceName);
+		if (ctrSpans < 0)
+			printf("\n[ERROR] A writing error was detected while writing to file \"%s\".\n", traceName);
+		else
+			printf("\n[SYSTEM] %d span(s) written to \"%s\".\n", ctrSpans, traceName);
+	}
+
 	return 0;
 }